@@ -15,6 +15,8 @@ int main(int argc, char** argv) {
         cout << "Insert flags at the end of the inputs." << endl;
         cout << "-v/V = Verbose mode" << endl;
         cout << "--augmented-grammar = Input grammar already in augmented grammar form." << endl;
+        cout << "--eliminate-unit-rules = Bypass the reductions by unit rules A -> B in the parsing table." << endl;
+        cout << "--parallel = Build the parsing table with every available core." << endl;
         return 0;
     }
     else {
@@ -24,12 +26,17 @@ int main(int argc, char** argv) {
             if (argc < 4)
                 AbortTranslation(compiler::error::InvalidCommandLineArgs);
             else{
-                bool verbose = false, augment_grammar = true;
+                bool verbose = false, augment_grammar = true, eliminate_unit_rules = false;
+                unsigned threads = 1;
                 for (int i = 4; i < argc; ++i) {
                     if(std::strcmp(argv[i], "-v") == 0 || std::strcmp(argv[i], "-V") == 0)
                         verbose = true;
                     else if(std::strcmp(argv[i], "--augmented-grammar") == 0)
                         augment_grammar = false;
+                    else if(std::strcmp(argv[i], "--eliminate-unit-rules") == 0)
+                        eliminate_unit_rules = true;
+                    else if(std::strcmp(argv[i], "--parallel") == 0)
+                        threads = 0;
                     else
                         AbortTranslation(compiler::error::InvalidCommandLineArgs);
                 }
@@ -41,13 +48,17 @@ int main(int argc, char** argv) {
                 if(ifstream(argv[3]).good()) {
                     compiler::io_buffer::TextSourceBuffer input_file(argv[3]);
                     compiler::analyzers::LexicalAnalyzerF tokenizer(&input_file, analyzer);
-                    compiler::parsers::LR1 yacc(&input_grammar, tokenizer, augment_grammar);
+                    compiler::parsers::LR1 yacc(&input_grammar, tokenizer, augment_grammar, threads);
+                    if(eliminate_unit_rules)
+                        yacc.EliminateUnitReductions();
                     bool accepted = yacc.Parse(verbose);
                     cout << endl << "Accepted string? " << (accepted ? "true" : "false") << endl << endl;
                 }
                 else{
                     compiler::analyzers::LexicalAnalyzerS tokenizer(argv[3], analyzer);
-                    compiler::parsers::LR1 yacc(&input_grammar, tokenizer, augment_grammar);
+                    compiler::parsers::LR1 yacc(&input_grammar, tokenizer, augment_grammar, threads);
+                    if(eliminate_unit_rules)
+                        yacc.EliminateUnitReductions();
                     bool accepted = yacc.Parse(verbose);
                     cout << endl << "Accepted string? " << (accepted ? "true" : "false") << endl << endl;
                 }
@@ -0,0 +1,54 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "automata/nfa.h"
+#include "automata/dfa.h"
+#include "parsers/regex_utils/regex_scanner.h"
+#include "parsers/regex_utils/regex_parser.h"
+#include "parsers/regex_utils/regex_dfa.h"
+
+using namespace std;
+
+namespace {
+    template<typename Function>
+    double Measure(int repetitions, Function function) {
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; ++i)
+            function();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / repetitions;
+    }
+}
+
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        cout << "syntax: [input regex file_] [repetitions]" << endl;
+        cout << "Compares the Thompson NFA + subset construction pipeline against the direct followpos construction." << endl;
+        return 0;
+    }
+    int repetitions = argc > 2 ? atoi(argv[2]) : 10;
+    if (repetitions <= 0)
+        AbortTranslation(compiler::error::InvalidCommandLineArgs);
+
+    compiler::io_buffer::TextSourceBuffer input_regex(argv[1]);
+    compiler::regex::RegexParser parser{compiler::regex::RegexScanner(&input_regex)};
+    const auto &rules = parser.ParseRules();
+
+    int subset_states = 0, direct_states = 0;
+    double subset_time = Measure(repetitions, [&]() {
+        std::vector<compiler::automata::NFA> automata;
+        for (std::size_t i = 0; i < rules.size(); ++i) {
+            automata.push_back(compiler::regex::BuildNFA(rules[i].regex));
+            automata.back().AddAcceptingValue(rules[i].action, (int) i);
+        }
+        subset_states = compiler::automata::NFA::CalculateLexicalUnion(automata).ToDFA().size();
+    });
+    double direct_time = Measure(repetitions, [&]() {
+        direct_states = compiler::regex::BuildDFA(rules).size();
+    });
+
+    cout << "Rules: " << rules.size() << ", repetitions: " << repetitions << endl;
+    cout << "Thompson NFA + ToDFA: " << subset_time << " ms, " << subset_states << " states" << endl;
+    cout << "Direct followpos:     " << direct_time << " ms, " << direct_states << " states" << endl;
+    return 0;
+}
@@ -0,0 +1,83 @@
+#ifndef COMPILER_COMPILED_LEXER_H
+#define COMPILER_COMPILED_LEXER_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "automata/dfa.h"
+#include "automata/nfa.h"
+#include "analyzers/keyword_table.h"
+
+namespace compiler::analyzers {
+
+    class CompiledLexer;
+
+    using LexerModes = std::map<std::string, std::shared_ptr<const CompiledLexer>>; //!< Lexer of every start condition.
+
+    /*!
+     * @brief Immutable transition tables of a lexical analyzer.
+     * @details Flattens an automata::DFA into a dense table indexed by state and input byte. Every method is const,
+     * so a single CompiledLexer can be shared (through a std::shared_ptr) by any number of LexicalAnalyzer cursors
+     * running on different threads.
+     */
+    class CompiledLexer {
+    private:
+        static const int kAlphabetSize = 256; //!< Number of columns per state, one for every byte value.
+
+        int initial_state_;
+        std::vector<int> transitions_; //!< Next state of (state, byte) at state * kAlphabetSize + byte, -1 if none.
+        std::vector<char> accepting_;  //!< Non-zero for every accepting state.
+        std::vector<std::string> tokens_; //!< Token name of every accepting state.
+        std::shared_ptr<const KeywordTable> keywords_; //!< Keywords of the identifier token, may be null.
+
+    public:
+        /*!
+         * @param automata DFA of the lexical union of the rules.
+         * @param keywords Optional keyword table applied to the lexemes of its identifier token, so keywords need no
+         * rules (and no DFA states) of their own.
+         */
+        explicit CompiledLexer(const automata::DFA &automata, std::shared_ptr<const KeywordTable> keywords = nullptr);
+
+        [[nodiscard]] int initial_state() const { return initial_state_; }
+
+        /*!
+         * @brief Transition function of the lexer.
+         * @param state Current state, must not be -1.
+         * @param c Input character.
+         * @return The next state, or -1 if there is no transition.
+         */
+        [[nodiscard]] int Compute(int state, char c) const {
+            return transitions_[state * kAlphabetSize + (unsigned char) c];
+        }
+
+        [[nodiscard]] bool isAccepting(int state) const { return accepting_[state]; }
+
+        [[nodiscard]] const std::string &token(int state) const { return tokens_[state]; }
+
+        /*!
+         * @brief Gets the final token name of a lexeme recognized as @p token_name, see KeywordTable::Classify().
+         */
+        [[nodiscard]] const std::string &Classify(const std::string &token_name, std::string_view lexeme) const {
+            return keywords_ ? keywords_->Classify(token_name, lexeme) : token_name;
+        }
+
+        /*!
+         * @brief Builds the tables of the minimized DFA of the lexical union of @p rules.
+         */
+        static std::shared_ptr<const CompiledLexer> Compile(const std::vector<automata::NFA> &rules,
+                                                            std::shared_ptr<const KeywordTable> keywords = nullptr);
+
+        /*!
+         * @brief Builds one CompiledLexer per start condition.
+         * @param mode_rules Rules of every start condition, as returned by regex::RegexParser::ParseModes().
+         */
+        static std::shared_ptr<const LexerModes>
+        CompileModes(const std::map<std::string, std::vector<automata::NFA>> &mode_rules,
+                     const std::shared_ptr<const KeywordTable> &keywords = nullptr);
+    };
+} //namespace compiler::analyzers
+
+#endif //COMPILER_COMPILED_LEXER_H
@@ -0,0 +1,75 @@
+#ifndef COMPILER_INCREMENTAL_LEXER_H
+#define COMPILER_INCREMENTAL_LEXER_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "analyzers/compiled_lexer.h"
+#include "analyzers/lexical_analyzer_s.h"
+
+namespace compiler::analyzers {
+
+    /*!
+     * @brief Token of a document with its position.
+     */
+    struct TokenSpan {
+        Token token;
+        std::size_t begin; //!< Offset of the first character of the lexeme.
+        std::size_t end;   //!< Offset where the analyzer stopped after the token, the next token starts here or later.
+    };
+
+    /*!
+     * @brief Tokens replaced by an edit: tokens [first, first + removed) of the old stream became tokens
+     * [first, first + inserted) of the new one, and every following token was only moved.
+     */
+    struct TokenEdit {
+        std::size_t first;
+        std::size_t removed;
+        std::size_t inserted;
+    };
+
+    /*!
+     * @brief Token stream of a document that is kept up to date while the document is edited.
+     * @details Tokens are recognized exactly as LexicalAnalyzerS does. The analyzer reads one character past every
+     * token, the one without transition, so a token that stopped before the edit is still valid, and relexing
+     * restarts at the end of the last such token. Between tokens the only state of the analyzer is its offset, so
+     * relexing stops as soon as a new token ends after the edit at the offset where an old token ended: from there
+     * on the analyzer would read the same text as before and produce the same tokens, which are kept and moved.
+     * Every Edit() costs the tokens around the edit instead of the whole document.
+     */
+    class IncrementalLexer {
+    private:
+        LexicalAnalyzerS analyzer_;
+        std::string text_;
+        std::vector<TokenSpan> tokens_;
+
+        void Lex(std::size_t offset, std::vector<TokenSpan> &output);
+
+    public:
+        /*!
+         * @param lexer Compiled tables used to recognize the tokens.
+         * @param skip_whitespace If false, whitespace characters go through the automaton as any other character.
+         */
+        explicit IncrementalLexer(std::shared_ptr<const CompiledLexer> lexer, bool skip_whitespace = true);
+
+        /*!
+         * @brief Replaces the whole document with @p text and tokenizes it from the beginning.
+         */
+        void Reset(std::string text);
+
+        /*!
+         * @brief Replaces @p removed characters of the document at offset @p begin with @p inserted and relexes
+         * the tokens affected by the change.
+         * @return The range of tokens that changed.
+         */
+        TokenEdit Edit(std::size_t begin, std::size_t removed, std::string_view inserted);
+
+        [[nodiscard]] const std::string &text() const { return text_; }
+
+        [[nodiscard]] const std::vector<TokenSpan> &tokens() const { return tokens_; }
+    };
+} //namespace compiler::analyzers
+
+#endif //COMPILER_INCREMENTAL_LEXER_H
@@ -0,0 +1,61 @@
+#ifndef COMPILER_KEYWORD_TABLE_H
+#define COMPILER_KEYWORD_TABLE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace compiler::analyzers {
+
+    /*!
+     * @brief Classifies identifier lexemes as keywords with a perfect hash.
+     * @details Keywords are recognized by the generic identifier rule of the DFA and then looked up here, instead of
+     * being written as regex alternatives that multiply the states of the DFA. The table is built with the
+     * hash-and-displace method: keywords are grouped in buckets by a first hash, and every bucket gets a seed for a
+     * second hash that sends its keywords to free slots, so a lookup costs two hashes and one string compare.
+     */
+    class KeywordTable {
+    private:
+        struct Slot {
+            std::string keyword;
+            std::string token_name;
+        };
+
+        std::string identifier_token_;   //!< Token name of the rule whose lexemes may be keywords.
+        std::vector<std::uint32_t> seeds_; //!< Seed of the second hash for every bucket.
+        std::vector<Slot> slots_;        //!< Keyword and token name stored in every slot.
+
+        static std::uint32_t Hash(std::string_view key, std::uint32_t seed);
+
+        bool Build(const std::vector<std::pair<std::string, std::string>> &keywords, std::size_t table_size);
+
+    public:
+        /*!
+         * @param identifier_token Token name of the identifier rule, only its lexemes are classified.
+         * @param keywords Pairs of keyword and token name.
+         */
+        KeywordTable(std::string identifier_token, const std::vector<std::pair<std::string, std::string>> &keywords);
+
+        /*!
+         * @brief Reads a keyword table from @p fname, one "keyword TOKEN_NAME" pair per line.
+         */
+        static KeywordTable Load(const std::string &fname, std::string identifier_token);
+
+        /*!
+         * @brief Gets the token name of @p lexeme if it is a keyword.
+         * @return The token name of the keyword, or nullptr if @p lexeme is not a keyword.
+         */
+        [[nodiscard]] const std::string *Find(std::string_view lexeme) const;
+
+        /*!
+         * @brief Gets the final token name of a lexeme recognized by the DFA as @p token_name.
+         * @return The keyword token name if @p token_name is the identifier token and @p lexeme is a keyword,
+         * otherwise @p token_name.
+         */
+        [[nodiscard]] const std::string &Classify(const std::string &token_name, std::string_view lexeme) const;
+    };
+} //namespace compiler::analyzers
+
+#endif //COMPILER_KEYWORD_TABLE_H
@@ -1,9 +1,12 @@
 #ifndef COMPILER_LEXICAL_ANALYZER_H
 #define COMPILER_LEXICAL_ANALYZER_H
 
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
+#include "analyzers/compiled_lexer.h"
 #include "automata/dfa.h"
 
 namespace compiler::analyzers {
@@ -18,14 +21,21 @@ namespace compiler::analyzers {
 
     class LexicalAnalyzer {
     protected:
-        automata::DFA automata_;
+        std::shared_ptr<const CompiledLexer> lexer_;
         bool skip_whitespace_;
         Token current_token_;
+        std::shared_ptr<const LexerModes> modes_;
+        LexerModes::const_iterator mode_;
     public:
-        LexicalAnalyzer(automata::DFA automata, bool skip_whitespace) :
-                automata_(std::move(automata)),
+        LexicalAnalyzer(std::shared_ptr<const CompiledLexer> lexer, bool skip_whitespace) :
+                lexer_(std::move(lexer)),
                 skip_whitespace_(skip_whitespace) {};
 
+        LexicalAnalyzer(const automata::DFA &automata, bool skip_whitespace) :
+                LexicalAnalyzer(std::make_shared<const CompiledLexer>(automata), skip_whitespace) {};
+
+        virtual ~LexicalAnalyzer() = default;
+
         virtual Token yylex() = 0;
 
         virtual bool isInEnd() = 0;
@@ -33,6 +43,42 @@ namespace compiler::analyzers {
         virtual char SkipWS() = 0;
 
         Token current_token() { return current_token_; };
+
+        [[nodiscard]] const std::shared_ptr<const CompiledLexer> &lexer() const { return lexer_; };
+
+        /*!
+         * @brief Sets the lexers of every start condition and begins in @p initial_mode.
+         * @details The previous modes are kept if BeginMode() throws.
+         */
+        void set_modes(std::shared_ptr<const LexerModes> modes, const std::string &initial_mode = "INITIAL") {
+            modes_.swap(modes);
+            try {
+                BeginMode(initial_mode);
+            } catch (...) {
+                modes_.swap(modes);
+                throw;
+            }
+        }
+
+        /*!
+         * @brief Switches to the start condition @p mode, the next token is recognized with its lexer.
+         * @throws std::out_of_range if @p mode is not in the modes given to set_modes().
+         */
+        virtual void BeginMode(const std::string &mode) {
+            auto new_mode = modes_ ? modes_->find(mode) : LexerModes::const_iterator();
+            if (!modes_ || new_mode == modes_->end())
+                throw std::out_of_range("Unknown start condition " + mode);
+            mode_ = new_mode;
+            lexer_ = mode_->second;
+        }
+
+        /*!
+         * @return The current start condition, "INITIAL" if set_modes() was never called.
+         */
+        [[nodiscard]] const std::string &mode() const {
+            static const std::string kInitialMode = "INITIAL";
+            return modes_ ? mode_->first : kInitialMode;
+        };
     };
 } //namespace compiler::analyzers
 
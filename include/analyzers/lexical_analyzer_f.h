@@ -11,7 +11,16 @@ namespace compiler::analyzers {
     protected:
         io_buffer::TextSourceBuffer *input_file_;
     public:
-        LexicalAnalyzerF(io_buffer::TextSourceBuffer *inputFile, automata::DFA automata, bool skip_whitespace = true);
+        LexicalAnalyzerF(io_buffer::TextSourceBuffer *inputFile, const automata::DFA &automata, bool skip_whitespace = true);
+
+        LexicalAnalyzerF(io_buffer::TextSourceBuffer *inputFile, std::shared_ptr<const CompiledLexer> lexer,
+                         bool skip_whitespace = true);
+
+        /*!
+         * @brief Starts tokenizing @p inputFile from its current position.
+         * @details Nothing is copied or allocated, the analyzer keeps sharing its compiled tables.
+         */
+        void Reset(io_buffer::TextSourceBuffer *inputFile);
 
         Token yylex() override;
 
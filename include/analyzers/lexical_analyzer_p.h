@@ -0,0 +1,56 @@
+#ifndef COMPILER_LEXICAL_ANALYZER_P_H
+#define COMPILER_LEXICAL_ANALYZER_P_H
+
+#include <string>
+#include <vector>
+
+#include "analyzers/lexical_analyzer.h"
+#include "automata/dfa.h"
+
+namespace compiler::analyzers {
+
+    /*!
+     * @brief Lexical analyzer that tokenizes a whole file in parallel.
+     * @details The input file is mapped in memory and split into one chunk per thread. Since a token never spans
+     * a whitespace character (see LexicalAnalyzerF::isEOS()), every whitespace is a synchronizing point where the
+     * DFA is back in its initial state, so chunk limits are moved forward to the next whitespace and every chunk is
+     * tokenized independently. The token streams are stitched together in order and served by yylex().
+     * Start conditions are not supported, since the whole file is tokenized before the first token is read.
+     */
+    class LexicalAnalyzerP : public LexicalAnalyzer {
+    private:
+        std::vector<Token> tokens_;
+        std::vector<Token>::size_type position_ = 0;
+
+        void Tokenize(const char *begin, const char *end, std::vector<Token> &output);
+
+    public:
+        /*!
+         * @param fname File name of the input stream.
+         * @param lexer Compiled tables used to recognize the tokens.
+         * @param skip_whitespace If false, every whitespace character is returned as an ANY token.
+         * @param threads Number of worker threads, 0 uses every available core.
+         */
+        LexicalAnalyzerP(const std::string &fname, std::shared_ptr<const CompiledLexer> lexer,
+                         bool skip_whitespace = true, unsigned threads = 0);
+
+        LexicalAnalyzerP(const std::string &fname, const automata::DFA &automata, bool skip_whitespace = true,
+                         unsigned threads = 0);
+
+        Token yylex() override;
+
+        bool isInEnd() override;
+
+        char SkipWS() override;
+
+        /*!
+         * @throws std::logic_error always, the tokens are already computed with the lexer of the constructor.
+         */
+        void BeginMode(const std::string &mode) override;
+
+        [[nodiscard]] const std::vector<Token> &tokens() const { return tokens_; }
+    };
+} //namespace compiler::analyzers
+
+
+#endif //COMPILER_LEXICAL_ANALYZER_P_H
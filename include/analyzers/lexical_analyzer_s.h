@@ -2,6 +2,7 @@
 #define COMPILER_LEXICAL_ANALYZER_S_H
 
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "analyzers/lexical_analyzer.h"
@@ -10,16 +11,43 @@
 namespace compiler::analyzers {
     class LexicalAnalyzerS : public LexicalAnalyzer {
     private:
-        std::string str_input_;
-        std::string::iterator str_pos_;
+        std::string str_input_;              //!< Owned copy of the input, used only when the input was copied.
+        std::string_view input_;             //!< Input being tokenized.
+        std::string_view::const_iterator str_pos_ = input_.begin();
     public:
-        LexicalAnalyzerS(std::string strInput, automata::DFA automata, bool skip_whitespace = true);
+        LexicalAnalyzerS(std::string strInput, const automata::DFA &automata, bool skip_whitespace = true);
 
-        explicit LexicalAnalyzerS(automata::DFA automata, bool skip_whitespace = true) :
-                LexicalAnalyzer(std::move(automata), skip_whitespace) {};
+        LexicalAnalyzerS(std::string strInput, std::shared_ptr<const CompiledLexer> lexer, bool skip_whitespace = true);
 
+        explicit LexicalAnalyzerS(const automata::DFA &automata, bool skip_whitespace = true) :
+                LexicalAnalyzer(automata, skip_whitespace) {};
+
+        explicit LexicalAnalyzerS(std::shared_ptr<const CompiledLexer> lexer, bool skip_whitespace = true) :
+                LexicalAnalyzer(std::move(lexer), skip_whitespace) {};
+
+        /*!
+         * @brief Copies @p new_str and starts tokenizing it from the beginning.
+         * @details The copy reuses the capacity of the previous input, so no allocation is done when the new
+         * input is not longer than any previous one.
+         */
         void set_str_input(const std::string &new_str);
 
+        /*!
+         * @brief Starts tokenizing @p input from the beginning without copying it.
+         * @warning @p input must outlive every call to yylex() until the next Reset() or set_str_input().
+         */
+        void Reset(std::string_view input);
+
+        /*!
+         * @brief Continues tokenizing the current input from @p offset.
+         */
+        void Seek(std::size_t offset);
+
+        /*!
+         * @brief Gets the offset in the input of the next character to read.
+         */
+        [[nodiscard]] std::size_t offset() const { return str_pos_ - input_.begin(); }
+
         Token yylex() override;
 
         bool isInEnd() override;
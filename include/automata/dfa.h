@@ -4,6 +4,7 @@
 #include <map>
 #include <set>
 #include <cstdio>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -17,19 +18,22 @@ namespace compiler::automata {
         int initial_state_;
         std::set<int> accepting_states_;
         std::map<int, std::string> tokens_;
+        std::map<int, int> rules_; //!< Id of the rule recognized by every accepting state.
     public:
         std::set<int> InverseTransition(const std::set<int> &new_states, char input_char);
 
         int Compute(const std::string &string_input);
 
         DFA(int size, std::set<char> alphabet, std::map<std::pair<int, char>, int> transitions,
-            int initial_state, std::set<int> accepting_states, std::map<int, std::string> tokens) :
+            int initial_state, std::set<int> accepting_states, std::map<int, std::string> tokens,
+            std::map<int, int> rules) :
                 size_(size),
                 alphabet_(std::move(alphabet)),
                 transitions_(std::move(transitions)),
                 initial_state_(initial_state),
                 accepting_states_(std::move(accepting_states)),
-                tokens_(std::move(tokens)) {
+                tokens_(std::move(tokens)),
+                rules_(std::move(rules)) {
             for (int j = 1; j <= size; j++)
                 states_.insert(j);
         }
@@ -38,17 +42,28 @@ namespace compiler::automata {
 
         void PrintToFile(const std::string &filename);
 
+        /*!
+         * @brief Gets the minimal DFA of the same language.
+         * @details Accepting states start in one partition per rule id, so states of different rules are never
+         * merged even if their tokens have the same name.
+         */
         DFA Minimize();
 
         std::string ComputeString(const std::string &str);
 
-        const std::set<int> &accepting_states();
+        [[nodiscard]] const std::set<int> &accepting_states() const;
 
-        const std::map<int, std::string> &tokens();
+        [[nodiscard]] const std::map<int, std::string> &tokens() const;
 
-        int initial_state();
+        [[nodiscard]] const std::map<int, int> &rules() const;
 
-        int Compute(int state, char c);
+        [[nodiscard]] const std::map<std::pair<int, char>, int> &transitions() const;
+
+        [[nodiscard]] int initial_state() const;
+
+        [[nodiscard]] int size() const;
+
+        [[nodiscard]] int Compute(int state, char c) const;
     };
 
 } //nampespace compiler::automata
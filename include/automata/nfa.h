@@ -20,6 +20,7 @@ namespace compiler::automata {
         std::map <std::pair<int, char>, std::set<int>> transitions_;
         std::set<int> accepting_states_;
         std::map<int, std::string> accepting_values_;
+        std::map<int, int> accepting_rules_; //!< Rule id of every accepting state with a value.
         std::set<int> ComputeNextStates(int state, char symbol = '\0');
 
         std::set<int> CalculateEpsilonClosure(int state);
@@ -30,6 +31,8 @@ namespace compiler::automata {
 
         void AddTransition(int from, const std::set<int> &to, char symbol);
 
+        int SelectAcceptingState(const std::vector<int> &states);
+
         static int state_counter() {
             int number = NFA::state_counter_;
             NFA::state_counter_++;
@@ -63,11 +66,23 @@ namespace compiler::automata {
 
         NFA Optional();
 
+        /*!
+         * @brief Copies the automaton with fresh state numbers, so the copy can be combined with the original.
+         */
+        [[nodiscard]] NFA Clone() const;
+
+        [[nodiscard]] std::size_t size() const { return states_.size(); }
+
         virtual ~NFA();
 
         friend std::ostream &operator<<(std::ostream &ostream1, const NFA &obj);
 
-        void AddAcceptingValue(const std::string &value);
+        /*!
+         * @brief Assigns the token @p value of rule @p rule to every accepting state.
+         * @details When a DFA state or a lexeme is accepted by several rules, the rule with the greatest id wins,
+         * so specifications list their general rules first and the rules that override them afterwards.
+         */
+        void AddAcceptingValue(const std::string &value, int rule);
 
         NFA();
 
@@ -106,6 +106,14 @@ namespace compiler::io_buffer {
 
         public:
             explicit TextSourceBuffer(const std::string &fname);
+
+            /*!
+            * @brief   Closes the current input stream and starts reading @p fname.
+            * @details  The text buffer is reused, so readers holding this buffer (e.g. a lexical analyzer) can
+            *          continue with a new file without being rebuilt.
+            * @param    fname File name of the new input stream.
+            */
+            void Reopen(const std::string &fname);
         };
 
 
@@ -37,10 +37,16 @@ namespace compiler::error {
         UnknownSymbol = -15,
         MissingSymbol = -16,
         MissingRuleName = -17,
-        MissingQuotationMark = -18
+        MissingQuotationMark = -18,
+        BadStartCondition = -19,
+        InvalidUtf8 = -20,
+        BadRepetition = -21,
+        RepetitionTooLarge = -22,
+        BadDefinition = -23,
+        MissingPrecedenceSymbol = -24
     };
 
-    static const std::string abort_msg[19] = {
+    static const std::string abort_msg[25] = {
             "",
             "Invalid command line arguments",
             "Failed to open source file",
@@ -59,7 +65,13 @@ namespace compiler::error {
             "Found unknown expression when parsing symbol",
             "Missing symbol between apostrophes",
             "Missing rule name",
-            "Missing quotation mark in terminal Symbol"
+            "Missing quotation mark in terminal Symbol",
+            "Missing > or name in start condition list",
+            "Malformed UTF-8 sequence in regular expression",
+            "Malformed counted repetition, expected {m}, {m,} or {m,n} with m <= n",
+            "Counted repetition too large, the expanded automaton exceeds the state limit",
+            "Malformed definition, expected a name followed by a regular expression",
+            "Missing terminal symbol in precedence declaration"
     };; /*!< Stores the extended description for every code in AbortCode*/
 
 /*!
@@ -0,0 +1,154 @@
+/*!
+ * @file frozen_grammar.h
+ * @brief Integer encoded snapshot of a GrammarArray
+ * @details Class FrozenGrammar stores the symbols and rules of a grammar in flat arrays, for the table generators.
+ */
+
+#ifndef COMPILER_FROZEN_GRAMMAR_H
+#define COMPILER_FROZEN_GRAMMAR_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace compiler::grammar {
+
+    class GrammarArray;
+
+    /*!
+     * @brief Precedence of a terminal or a rule, declared with %left, %right or %nonassoc as in yacc.
+     */
+    struct Precedence {
+        enum class Associativity {
+            kLeft,
+            kRight,
+            kNonAssoc
+        };
+
+        int level = 0; //!< Declarations further down have higher levels, 0 if there is none.
+        Associativity associativity = Associativity::kLeft;
+    };
+
+    /*!
+     * @brief Read only view of contiguous elements of a FrozenGrammar.
+     */
+    template<typename T>
+    class Range {
+    private:
+        const T *first_ = nullptr;
+        const T *last_ = nullptr;
+    public:
+        Range() = default;
+
+        Range(const T *first, const T *last) : first_(first), last_(last) {}
+
+        [[nodiscard]] const T *begin() const { return first_; }
+
+        [[nodiscard]] const T *end() const { return last_; }
+
+        [[nodiscard]] std::size_t size() const { return last_ - first_; }
+
+        [[nodiscard]] bool empty() const { return first_ == last_; }
+
+        const T &operator[](std::size_t index) const { return first_[index]; }
+    };
+
+    /*!
+     * @brief Grammar with its symbols replaced by integer ids and its rules stored in flat arrays.
+     *
+     * @details Terminals take the ids [0, terminal_count()), "$" (end of input) included, and variables the ids
+     * [terminal_count(), symbol_count()), so a symbol is a terminal if its id is lower than terminal_count(). The
+     * right sides of the rules are stored one after the other in a single array (compressed sparse rows) and "#"
+     * (epsilon) is dropped, so an epsilon rule has an empty right side. Rules keep the index of
+     * GrammarArray::GetRuleFromIndex() and the rules of every variable are stored contiguously in index order.
+     * @attention The snapshot isn't updated when the GrammarArray it was built from changes.
+     */
+    class FrozenGrammar {
+    public:
+        using Symbol = int;
+
+    private:
+        std::vector<std::string> names_;               //!< Name of every symbol id.
+        std::unordered_map<std::string, Symbol> ids_;  //!< Id of every symbol name.
+        int terminal_count_ = 0;
+        Symbol axiom_ = -1;
+        Symbol end_ = -1;                              //!< Id of "$".
+
+        std::vector<Symbol> left_;                     //!< Variable of every rule.
+        std::vector<int> right_offsets_;               //!< Start of the right side of every rule, plus the end.
+        std::vector<Symbol> right_;                    //!< Right sides of every rule, one after the other.
+
+        std::vector<int> rule_offsets_;                //!< Start of the rules of every variable, plus the end.
+        std::vector<int> rules_;                       //!< Rule indexes grouped by variable.
+
+        std::vector<Precedence> precedences_;          //!< Precedence of every terminal.
+        std::vector<Precedence> rule_precedences_;     //!< Precedence of every rule.
+
+    public:
+        FrozenGrammar() = default;
+
+        /*!
+         * @brief Encodes every terminal, variable and rule of @p grammar.
+         */
+        explicit FrozenGrammar(const GrammarArray &grammar);
+
+        [[nodiscard]] int symbol_count() const { return (int) names_.size(); }
+
+        [[nodiscard]] int terminal_count() const { return terminal_count_; }
+
+        [[nodiscard]] int variable_count() const { return symbol_count() - terminal_count_; }
+
+        [[nodiscard]] int rule_count() const { return (int) left_.size(); }
+
+        [[nodiscard]] bool IsTerminal(Symbol symbol) const { return symbol < terminal_count_; }
+
+        /*!
+         * @brief Gets the position of @p variable among the variables, to index arrays of variables.
+         */
+        [[nodiscard]] int VariableIndex(Symbol variable) const { return variable - terminal_count_; }
+
+        /*!
+         * @return The id of the symbol @p name, or -1 if it isn't in the grammar.
+         */
+        [[nodiscard]] Symbol Id(const std::string &name) const;
+
+        [[nodiscard]] const std::string &Name(Symbol symbol) const { return names_[symbol]; }
+
+        [[nodiscard]] Symbol axiom() const { return axiom_; }
+
+        /*!
+         * @return The id of "$", the end of input.
+         */
+        [[nodiscard]] Symbol end() const { return end_; }
+
+        /*!
+         * @return The variable that generates the rule with index @p rule.
+         */
+        [[nodiscard]] Symbol Left(int rule) const { return left_[rule]; }
+
+        /*!
+         * @return The right side of the rule with index @p rule.
+         */
+        [[nodiscard]] Range<Symbol> Right(int rule) const {
+            return {right_.data() + right_offsets_[rule], right_.data() + right_offsets_[rule + 1]};
+        }
+
+        /*!
+         * @return The indexes of the rules generated by @p variable.
+         */
+        [[nodiscard]] Range<int> Rules(Symbol variable) const {
+            int index = VariableIndex(variable);
+            return {rules_.data() + rule_offsets_[index], rules_.data() + rule_offsets_[index + 1]};
+        }
+
+        [[nodiscard]] const Precedence &TerminalPrecedence(Symbol terminal) const { return precedences_[terminal]; }
+
+        /*!
+         * @return The precedence of the rule with index @p rule, see GrammarArray::GetRulePrecedence().
+         */
+        [[nodiscard]] const Precedence &RulePrecedence(int rule) const { return rule_precedences_[rule]; }
+    };
+} // namespace compiler::grammar
+
+#endif //COMPILER_FROZEN_GRAMMAR_H
@@ -11,6 +11,8 @@ namespace compiler::grammar {
 
         static automata::DFA CreateAutomaton();
 
+        static std::shared_ptr<const analyzers::CompiledLexer> CreateLexer();
+
     public:
         explicit GrammarAnalyzer(io_buffer::TextSourceBuffer *input_file);
     };
@@ -11,8 +11,12 @@
 #include <map>
 #include <set>
 #include <iostream>
+#include <unordered_map>
 #include <vector>
 
+#include "parsers/grammar_utils/frozen_grammar.h"
+#include "parsers/grammar_utils/terminal_set.h"
+
 namespace compiler::grammar {
 /*!
  * @brief Class which stores a grammar.
@@ -71,41 +75,47 @@ namespace compiler::grammar {
         Bimap index_rule_; //!< Rule indexer for #rules_array_.
         /*!< Saves every rule found in #rules_array_ and assigns them a unique index. Used in class LL1. */
 
+        std::map<std::string, Precedence> precedences_; //!< Declared precedence of the terminals.
 
+        std::map<int, std::string> rule_precedences_; //!< Terminal given with %prec to a rule index.
 
-        /*!
-         * @brief Calculates the structure of the variable in @p expression.
-         * @details Calculates only the follow of expressions found in #terminals or #non_terminals_, or the follow of the
-         * special string "#" (epsilon).
-         * @param variable Variable or terminal symbol to which we want to calculate its follow.
-         * @param calculated Helper set that saves every expression already analyzed by follow, to ensure the method
-         * doesn't enter in a infinite loop.
-         * @return A set containing every non terminal symbol that is in the follow of @p expression.
-         */
-        std::set<std::string> Follow(const std::string &variable, std::set<std::string> &calculated);
+        FrozenGrammar frozen_grammar_; //!< Cached result of Freeze().
+
+        bool frozen_ = false; //!< #frozen_grammar_ is up to date with the rules.
+
+        bool analyzed_ = false; //!< The cached sets below are up to date with the rules.
+
+        std::vector<char> nullable_; //!< Non-zero for every variable that can generate "#" (epsilon).
+        /*!< Like #first_ and #follow_, indexed by FrozenGrammar::VariableIndex(). */
+
+        std::vector<TerminalSet> first_; //!< First of every variable, without "#".
+
+        std::vector<TerminalSet> follow_; //!< Follow of every variable.
+
+        std::unordered_map<std::string, std::set<std::string>> first_sets_; //!< Cached result of First(symbol).
+
+        std::vector<std::set<std::string>> follow_sets_; //!< Cached result of Follow(variable).
 
         /*!
-         * @brief Determines if @p variable expression can generate from its rules the special string "#" (epsilon).
-         * @param variable String which we want to determine if it can generate epsilon.
-         * @return True if @p variable can generate epsilon. Else, false.
+         * @brief Discards the cached frozen grammar and sets, called every time the grammar changes.
          */
-        bool canGenerateEpsilon(const std::string &variable);
-
-        bool canGenerateEpsilon(const std::string &variable, std::set<std::string> &calculated);
+        void Invalidate();
 
         /*!
-         * @brief Updates #terminals_ every time a new rule is inserted.
-         * @details Searches for every string not in #non_terminals_ for every rule in #rules_array_. If a symbol
-         * is not in #non_terminals_ and the symbol is not "#" (epsilon), the method stores it in #terminals_ for future uses.
+         * @brief Computes nullable, first and follow of every variable if the grammar changed since the last call.
+         * @details The three are least fixed points computed with worklists over the rules: a rule is analyzed again
+         * only when the set of a variable it depends on grows. Sets of terminals are bitsets indexed by the terminal
+         * ids of Freeze().
          */
-        void UpdateTerminals();
+        void Analyze();
 
         /*!
-         * @brief Gets every rule that contains @p variable in its right side.
-         * @param variable Symbol which we want to find in every right side of the grammar rules.
-         * @return A set containing every rule that contains @p variable in its right side.
+         * @brief Updates #terminals_ with the symbols of a new right side @p rule.
+         * @details Every symbol of @p rule that is not in #non_terminals_ and is not "#" (epsilon) is stored in
+         * #terminals_, so inserting a rule costs only the length of its right side. A symbol that becomes a
+         * variable later is erased by InsertRule().
          */
-        std::set<std::pair<std::string, std::vector<std::string>>> GetRightSides(const std::string &variable);
+        void AddTerminals(const std::vector<std::string> &rule);
 
     public:
 
@@ -118,6 +128,7 @@ namespace compiler::grammar {
         /*!
          * @brief Inserts a new rule in #rules_array_.
          * @attention This method will @b ALWAYS set #axiom_ to the first rule inserted in #rules_array_.
+         * A rule already in the grammar is ignored, so it keeps its index.
          * @param variable String that generates the expression string @p rule .
          * @param rule Succession of strings which define the rule generated by @p variable .
          */
@@ -126,33 +137,62 @@ namespace compiler::grammar {
         /*!
          * @brief Calculates the first of the expression string defined by @p expression_vector.
          * @param expression_vector Succession of strings defining a expression string which we want to get its first.
-         * @return A set containing every non terminal symbol that is in the first of @p expression_vector.
+         * @return A set containing every terminal symbol that is in the first of @p expression_vector, and "#" (epsilon)
+         * if the whole expression can generate epsilon.
          */
         std::set<std::string> First(const std::vector<std::string> &expression_vector);
 
         /*!
-         * @brief Calculates the first of the expression string defined by @p expression.
-         * @details It differs from First(const std::vector<std::string>& expression_vector) in where this method only
-         * calculates the first of terminal and non terminal symbols + "#" (epsilon).
-         * @param expression Symbol for which we want to calculate its first.
-         * @return A set containing every non terminal symbol that is in the first of @p expression.
+         * @brief Calculates the first of the symbols of @p expression_vector from @p from followed by @p lookahead.
+         * @details Used by the LR(1) closures, it avoids copying the rest of a rule to append its lookahead.
          */
-        std::set<std::string> First(const std::string &expression, std::set<std::string> &calculated);
+        std::set<std::string> First(const std::vector<std::string> &expression_vector, std::size_t from,
+                                    const std::string &lookahead);
 
         /*!
-         * @brief Calculates the follow of the variable defined by @p expression.
-         * @warning Undefined behavior if @p variable is not in #non_terminals_.
+         * @brief Gets the first of the symbol @p expression.
+         * @details The first of every variable is computed once for the whole grammar and cached.
+         * @param expression Terminal, variable or "#" (epsilon).
+         * @return A set containing every terminal symbol in the first of @p expression, and "#" if @p expression can
+         * generate epsilon.
+         */
+        const std::set<std::string> &First(const std::string &expression);
+
+        /*!
+         * @brief Gets the follow of the variable defined by @p variable.
+         * @details The follow of every variable is computed once for the whole grammar and cached.
          * @param variable Symbol for which we want to calculate its follow.
-         * @return A set containing every non terminal symbol that is in the follow of @p expression.
+         * @return A set containing every terminal symbol that is in the follow of @p variable, empty if @p variable is
+         * not in #non_terminals_.
+         */
+        const std::set<std::string> &Follow(const std::string &variable);
+
+        /*!
+         * @brief Determines if @p symbol can generate the special string "#" (epsilon).
          */
-        std::set<std::string> Follow(const std::string &variable);
+        bool Nullable(const std::string &symbol);
+
+        /*!
+         * @brief Determines if the variable with id @p variable of Freeze() can generate "#" (epsilon).
+         */
+        bool Nullable(FrozenGrammar::Symbol variable);
+
+        /*!
+         * @brief Gets the first of the variable with id @p variable of Freeze(), without "#" (epsilon).
+         */
+        const TerminalSet &FirstSet(FrozenGrammar::Symbol variable);
+
+        /*!
+         * @brief Gets the follow of the variable with id @p variable of Freeze().
+         */
+        const TerminalSet &FollowSet(FrozenGrammar::Symbol variable);
 
         /*!
          * @brief Gets the rules generated by @p variable.
          * @param variable Variable which we want to find its rules.
          * @return A set containing every rule generated by @p variable.
          */
-        std::set<std::vector<std::string>> GetVariableRules(const std::string &variable);
+        [[nodiscard]] const std::set<std::vector<std::string>> &GetVariableRules(const std::string &variable) const;
 
         /*!
          * @brief Gets the index of the rule associated with @p variable and @p rule .
@@ -183,6 +223,12 @@ namespace compiler::grammar {
         GrammarArray GetAugmentedGrammar(std::string new_axiom = "");
 
 
+        /*!
+         * @brief Gets the integer encoded snapshot of the grammar used by the table generators.
+         * @details Built on the first call after the grammar changes and cached until the next change.
+         */
+        const FrozenGrammar &Freeze();
+
         /*!
          * @brief Getter for #axiom_.
          * @return #axiom_
@@ -221,13 +267,36 @@ namespace compiler::grammar {
          * @param variable Variable which we want to find its rules.
          * @return A set containing every rule generated by @p variable.
          */
-        std::set<std::vector<std::string>> operator[](const std::string &index);
+        const std::set<std::vector<std::string>> &operator[](const std::string &index) const;
 
         std::pair<std::string, std::vector<std::string>> GetRuleFromIndex(int index);
 
         [[nodiscard]] std::pair<std::string, std::vector<std::string>> GetRuleFromIndex(int index) const;
 
-        int size() { return index_rule_.size(); }
+        [[nodiscard]] int size() const { return index_rule_.size(); }
+
+        /*!
+         * @brief Declares the precedence and associativity of @p terminal, used to resolve shift/reduce conflicts.
+         */
+        void SetPrecedence(const std::string &terminal, Precedence precedence);
+
+        /*!
+         * @brief Gives the rule @p rule of @p variable the precedence of @p terminal, as %prec does.
+         */
+        void SetRulePrecedence(const std::string &variable, const std::vector<std::string> &rule,
+                               const std::string &terminal);
+
+        /*!
+         * @return The declared precedence of @p terminal, of level 0 if there is none.
+         */
+        [[nodiscard]] Precedence GetPrecedence(const std::string &terminal) const;
+
+        /*!
+         * @brief Gets the precedence of the rule with index @p index.
+         * @details The one of its %prec terminal if it has one, otherwise the one of the last terminal of its right
+         * side, as in yacc.
+         */
+        [[nodiscard]] Precedence GetRulePrecedence(int index) const;
 
         void InsertTerminal(const std::string &new_symbol);
 
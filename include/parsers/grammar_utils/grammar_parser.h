@@ -11,8 +11,15 @@ namespace compiler::grammar {
     private:
         GrammarAnalyzer scanner_;
 
+        int precedence_level_ = 0; //!< Level of the last precedence declaration.
+
         void Grammar(GrammarArray &new_grammar);
 
+        /*!
+         * @brief Parses a declaration like %left '+' '-'; , every declaration binding tighter than the previous ones.
+         */
+        void Declaration(GrammarArray &new_grammar);
+
         void Rule(GrammarArray &new_grammar);
 
         void RightSide(const std::string &left_s, GrammarArray &new_grammar);
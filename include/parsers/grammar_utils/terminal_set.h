@@ -0,0 +1,111 @@
+/*!
+ * @file terminal_set.h
+ * @brief Bitset of terminal ids
+ * @details Class TerminalSet stores sets of terminals of a FrozenGrammar, as first and follow sets or LR(1) lookaheads.
+ */
+
+#ifndef COMPILER_TERMINAL_SET_H
+#define COMPILER_TERMINAL_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace compiler::grammar {
+
+    /*!
+     * @brief Set of terminals indexed by their FrozenGrammar id, one bit per terminal.
+     * @details Sets built for the same grammar have the same size, so merging and comparing them is word by word.
+     */
+    class TerminalSet {
+    private:
+        std::vector<std::uint64_t> words_;
+
+    public:
+        TerminalSet() = default;
+
+        /*!
+         * @brief Creates an empty set able to store the terminals [0, @p terminal_count).
+         */
+        explicit TerminalSet(int terminal_count) : words_((terminal_count + 63) / 64, 0) {}
+
+        void Insert(int terminal) { words_[terminal / 64] |= std::uint64_t(1) << (terminal % 64); }
+
+        [[nodiscard]] bool Contains(int terminal) const { return words_[terminal / 64] >> (terminal % 64) & 1; }
+
+        /*!
+         * @brief Inserts every terminal of @p other, which must have the same size.
+         * @return True if the set grew.
+         */
+        bool Merge(const TerminalSet &other) {
+            bool changed = false;
+            for (std::size_t i = 0; i < words_.size(); ++i) {
+                std::uint64_t merged = words_[i] | other.words_[i];
+                changed = changed || merged != words_[i];
+                words_[i] = merged;
+            }
+            return changed;
+        }
+
+        /*!
+         * @return True if every terminal of @p other is in the set.
+         */
+        [[nodiscard]] bool Includes(const TerminalSet &other) const {
+            for (std::size_t i = 0; i < words_.size(); ++i) {
+                if (other.words_[i] & ~words_[i])
+                    return false;
+            }
+            return true;
+        }
+
+        /*!
+         * @return True if the set and @p other have a terminal in common.
+         */
+        [[nodiscard]] bool Intersects(const TerminalSet &other) const {
+            for (std::size_t i = 0; i < words_.size(); ++i) {
+                if (words_[i] & other.words_[i])
+                    return true;
+            }
+            return false;
+        }
+
+        void Clear() {
+            for (auto &word : words_)
+                word = 0;
+        }
+
+        [[nodiscard]] bool empty() const {
+            for (auto word : words_) {
+                if (word)
+                    return false;
+            }
+            return true;
+        }
+
+        /*!
+         * @brief Calls @p function with every terminal of the set, in increasing order.
+         */
+        template<typename Function>
+        void ForEach(Function function) const {
+            for (std::size_t i = 0; i < words_.size(); ++i) {
+                for (std::uint64_t word = words_[i]; word; word &= word - 1)
+                    function((int) (i * 64 + __builtin_ctzll(word)));
+            }
+        }
+
+        [[nodiscard]] std::size_t Hash() const {
+            std::size_t hash = words_.size();
+            for (auto word : words_)
+                hash ^= word + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+
+        bool operator==(const TerminalSet &obj) const { return words_ == obj.words_; }
+
+        bool operator!=(const TerminalSet &obj) const { return words_ != obj.words_; }
+
+        bool operator<(const TerminalSet &obj) const { return words_ < obj.words_; }
+    };
+} // namespace compiler::grammar
+
+#endif //COMPILER_TERMINAL_SET_H
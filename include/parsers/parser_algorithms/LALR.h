@@ -1,53 +1,55 @@
 #ifndef COMPILER_LALR_H
 #define COMPILER_LALR_H
 
-#include "parsers/parser_algorithms/parser.h"
+#include "parsers/parser_algorithms/lr_parser.h"
+#include "parsers/parser_algorithms/lr0_automaton.h"
 #include "parsers/parser_algorithms/LR0.h"
 #include "parsers/parser_algorithms/conflict_man.h"
 
 namespace compiler::parsers {
-    class LALR : public Parser<std::map<std::pair<int, std::string>, std::pair<char, int>>>,
-                public ConflictManager{
+    class LALR : public LRParser {
     public:
-        LALR(io_buffer::TextSourceBuffer *input_file, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true) :
-                LALR(grammar::GrammarParser(input_file), tokenizer, augment_grammar) {}
+        LALR(io_buffer::TextSourceBuffer *input_file, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true,
+             unsigned threads=1) :
+                LALR(grammar::GrammarParser(input_file), tokenizer, augment_grammar, threads) {}
 
-        LALR(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true);
+        /*!
+         * @param threads Number of threads building the automaton of the table, 0 uses every available core.
+         */
+        LALR(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true,
+             unsigned threads=1);
 
         bool Parse(bool verbose) override;
 
     private:
-        struct Item {
-            LR0::Item lr0_item;
-            std::string token;
-
-            bool operator<(const Item& obj) const{
-                return lr0_item.GetFullString() + token < obj.lr0_item.GetFullString() + obj.token;
-            }
-
-
-        };
-
-        using ItemSet = std::set<Item>;
         using cell = std::pair<char, int>;
+        using Reductions = std::vector<std::vector<std::pair<int, grammar::TerminalSet>>>;
 
         int states_number_=0;
 
-        ItemSet ItemsClosure(const Item &item_input, ItemSet &calculated);
-
-        ItemSet ItemsClosure(const ItemSet &input_items);
-
-        ItemSet goTo(const ItemSet &input_items, const std::string &input_symbol);
-
-        void CreateParsingTable(const std::vector<std::tuple<std::string, ItemSet, ItemSet>> &states_function);
+        /*!
+         * @brief Computes the lookaheads of every complete item of @p automaton with the relations of DeRemer and
+         * Pennello.
+         * @details Every transition (p, A) on a variable gets the terminals that can follow A from p: the terminals
+         * read directly after A (DR), extended through the nullable variables read after it (reads), and then
+         * through the transitions whose rules end with A (includes), both closures computed with the digraph
+         * algorithm. The lookaheads of a reduction of B -> w in state q are the follows of the transitions (p, B)
+         * from where reading w reaches q (lookback).
+         * @return The complete rules of every state with their lookaheads.
+         */
+        Reductions ComputeLookaheads(const LR0Automaton &automaton, int start_rule);
+
+        /*!
+         * @brief Fills #function_ from the states of @p automaton, @p accept_item accepts on "$".
+         */
+        void CreateParsingTable(const LR0Automaton &automaton, const Reductions &reductions, PackedItem accept_item);
 
         void PrintParsingTable() override;
 
-        void PrintItemSet(const ItemSet &set);
+        void PrintItemSet(const LR0Automaton &automaton, const Reductions &reductions, int state);
 
-        void ThrowConflictError(Conflict c, const std::pair<ItemSet, int> &print_obj, const std::set<int> &rule_set,
-                                const std::string &symbol = "");
-        std::set<LALR::ItemSet> GenerateStates();
+        void ThrowConflictError(Conflict c, const LR0Automaton &automaton, const Reductions &reductions, int state,
+                                const std::set<int> &rule_set, const std::string &symbol = "");
     };
 }
 
@@ -11,6 +11,7 @@
 #include "analyzers/lexical_analyzer.h"
 #include "buffer.h"
 #include "parsers/parser_algorithms/conflict_man.h"
+#include "parsers/parser_algorithms/syntax_tree.h"
 
 namespace compiler::parsers {
 
@@ -25,6 +26,14 @@ namespace compiler::parsers {
 
         LL1(io_buffer::TextSourceBuffer *input_file, analyzers::LexicalAnalyzer &tokenizer);
         bool Parse(bool verbose) override;
+
+        /*!
+         * @brief Parses the input of the tokenizer and builds its concrete syntax tree in @p tree.
+         * @details The children of a variable are allocated together in the arena of @p tree when its rule is
+         * predicted, and filled in while they are matched.
+         * @return True if the input is accepted.
+         */
+        bool ParseTree(SyntaxTree &tree);
     };
 } // namespace compiler::parsers
 
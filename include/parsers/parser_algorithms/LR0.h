@@ -1,10 +1,12 @@
 #ifndef COMPILER_LR0_H
 #define COMPILER_LR0_H
 
+#include <tuple>
 #include <utility>
 
 #include "buffer.h"
-#include "parsers/parser_algorithms/parser.h"
+#include "parsers/parser_algorithms/lr_parser.h"
+#include "parsers/parser_algorithms/lr0_automaton.h"
 #include "parsers/parser_algorithms/conflict_man.h"
 #include "analyzers/lexical_analyzer.h"
 #include "parsers/grammar_utils/grammar_array.h"
@@ -12,8 +14,7 @@
 
 namespace compiler::parsers {
 
-    class LR0 : public Parser<std::map<std::pair<int, std::string>, std::pair<char, int>>>,
-                public ConflictManager{
+    class LR0 : public LRParser {
     public:
         struct Item {
             std::string variable;
@@ -31,11 +32,11 @@ namespace compiler::parsers {
             };
 
             bool operator==(const Item& obj) const{
-                return GetFullString() == obj.GetFullString();
+                return point == obj.point && variable == obj.variable && rule == obj.rule;
             }
 
             bool operator<(const Item& obj) const{
-                return GetFullString() < obj.GetFullString();
+                return std::tie(point, variable, rule) < std::tie(obj.point, obj.variable, obj.rule);
             }
 
             [[nodiscard]] const std::string& PointSymbol() const {return rule.at(point);}
@@ -46,30 +47,31 @@ namespace compiler::parsers {
 
         };
 
-        LR0(io_buffer::TextSourceBuffer *input_file, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true) :
-                LR0(grammar::GrammarParser(input_file), tokenizer, augment_grammar) {}
+        LR0(io_buffer::TextSourceBuffer *input_file, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true,
+            unsigned threads=1) :
+                LR0(grammar::GrammarParser(input_file), tokenizer, augment_grammar, threads) {}
 
-        LR0(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true);
+        /*!
+         * @param threads Number of threads building the automaton of the table, 0 uses every available core.
+         */
+        LR0(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true,
+            unsigned threads=1);
         bool Parse(bool verbose) override;
 
     private:
-        using ItemSet = std::set<Item>;
         using cell = std::pair<char, int>;
 
         int states_number_=0;
 
         void PrintParsingTable() override;
 
-        ItemSet ItemsClosure(const Item &item_input, ItemSet &calculated);
+        /*!
+         * @brief Fills #function_ from the states of @p automaton, @p accept_item accepts on "$".
+         */
+        virtual void CreateParsingTable(const LR0Automaton &automaton, PackedItem accept_item);
 
-        ItemSet ItemsClosure(const ItemSet &input_items);
-
-        ItemSet goTo(const ItemSet &input_items, const std::string &input_symbol);
-
-        virtual void CreateParsingTable(const std::vector<std::tuple<std::string, ItemSet, ItemSet>> &states_function);
-
-        void ThrowConflictError(Conflict c, const std::pair<ItemSet, int> &print_obj, const std::set<int> &rule_set,
-                const std::string &symbol = "");
+        void ThrowConflictError(Conflict c, const LR0Automaton &automaton, int state, const std::set<int> &rule_set,
+                                const std::string &symbol = "");
     };
 
 } // namespace const compiler::parsers
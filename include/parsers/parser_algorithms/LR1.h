@@ -1,51 +1,48 @@
 #ifndef COMPILER_LR1_H
 #define COMPILER_LR1_H
 
-#include "parsers/parser_algorithms/parser.h"
+#include "parsers/parser_algorithms/lr_parser.h"
+#include "parsers/parser_algorithms/lr1_automaton.h"
 #include "parsers/parser_algorithms/LR0.h"
 #include "parsers/parser_algorithms/conflict_man.h"
 
 namespace compiler::parsers {
-    class LR1 : public Parser<std::map<std::pair<int, std::string>, std::pair<char, int>>>,
-                public ConflictManager{
+    class LR1 : public LRParser {
     public:
-        LR1(io_buffer::TextSourceBuffer *input_file, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true) :
-                LR1(grammar::GrammarParser(input_file), tokenizer, augment_grammar) {}
+        LR1(io_buffer::TextSourceBuffer *input_file, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true,
+            unsigned threads=1) :
+                LR1(grammar::GrammarParser(input_file), tokenizer, augment_grammar, threads) {}
 
-        LR1(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true);
+        /*!
+         * @param threads Number of threads building the automaton of the table, 0 uses every available core.
+         */
+        LR1(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true,
+            unsigned threads=1);
 
         bool Parse(bool verbose) override;
 
-    private:
-        struct Item {
-            LR0::Item lr0_item;
-            std::string token;
-
-            bool operator<(const Item& obj) const{
-                return lr0_item.GetFullString() + token < obj.lr0_item.GetFullString() + obj.token;
-            }
-
-
-        };
+    protected:
+        /*!
+         * @brief Builds the table from the automaton of @p construction.
+         */
+        LR1(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar,
+            LR1Automaton::Construction construction, unsigned threads = 1);
 
-        using ItemSet = std::set<Item>;
+    private:
         using cell = std::pair<char, int>;
 
         int states_number_=0;
 
-        ItemSet ItemsClosure(const Item &item_input, ItemSet &calculated);
-
-        ItemSet ItemsClosure(const ItemSet &input_items);
-
-        ItemSet goTo(const ItemSet &input_items, const std::string &input_symbol);
-
-        void CreateParsingTable(const std::vector<std::tuple<std::string, ItemSet, ItemSet>> &states_function);
+        /*!
+         * @brief Fills #function_ from the states of @p automaton, @p accept_item accepts on "$".
+         */
+        void CreateParsingTable(const LR1Automaton &automaton, PackedItem accept_item);
 
         void PrintParsingTable() override;
 
-        void PrintItemSet(const ItemSet &set);
+        void PrintItemSet(const LR1Automaton &automaton, int state);
 
-        void ThrowConflictError(Conflict c, const std::pair<ItemSet, int> &print_obj, const std::set<int> &rule_set,
+        void ThrowConflictError(Conflict c, const LR1Automaton &automaton, int state, const std::set<int> &rule_set,
                                 const std::string &symbol = "");
     };
 }
@@ -0,0 +1,24 @@
+#ifndef COMPILER_PAGER_LR1_H
+#define COMPILER_PAGER_LR1_H
+
+#include "parsers/parser_algorithms/LR1.h"
+
+namespace compiler::parsers {
+    /*!
+     * @brief LR(1) parser whose table merges the weakly compatible states of the canonical collection.
+     * @details Never adds a conflict LR1 doesn't have, so it accepts every LR(1) grammar. On an LALR(1) grammar
+     * it usually has as many states as LALR, but the compatibility test is conservative and may keep apart two
+     * states of the same core that LALR merges without a conflict.
+     */
+    class PagerLR1 : public LR1 {
+    public:
+        PagerLR1(io_buffer::TextSourceBuffer *input_file, analyzers::LexicalAnalyzer &tokenizer,
+                 bool augment_grammar=true) :
+                PagerLR1(grammar::GrammarParser(input_file), tokenizer, augment_grammar) {}
+
+        PagerLR1(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true) :
+                LR1(std::move(parser), tokenizer, augment_grammar, LR1Automaton::Construction::kPager) {}
+    };
+}
+
+#endif //COMPILER_PAGER_LR1_H
@@ -3,7 +3,8 @@
 #include <utility>
 
 #include "buffer.h"
-#include "parsers/parser_algorithms/parser.h"
+#include "parsers/parser_algorithms/lr_parser.h"
+#include "parsers/parser_algorithms/lr0_automaton.h"
 #include "parsers/parser_algorithms/conflict_man.h"
 #include "analyzers/lexical_analyzer.h"
 #include "parsers/grammar_utils/grammar_array.h"
@@ -11,63 +12,32 @@
 
 namespace compiler::parsers {
 
-    class SLR1 : public Parser<std::map<std::pair<int, std::string>, std::pair<char, int>>>,
-                 public ConflictManager{
+    class SLR1 : public LRParser {
     public:
-        struct Item {
-            std::string variable;
-            std::vector<std::string> rule = {};
-            int point{};
-
-            Item() = default;
-
-            Item(std::string variable, std::vector<std::string> rule,
-                 int point):
-                    variable(std::move(variable)), rule(std::move(rule)), point(point) {}
-
-            Item(std::string var_input, std::vector<std::string> rule_input):
-                    variable(std::move(var_input)), rule(std::move(rule_input)), point(0){
-            };
-
-            bool operator==(const Item& obj) const{
-                return GetFullString() == obj.GetFullString();
-            }
-
-            bool operator<(const Item& obj) const{
-                return GetFullString() < obj.GetFullString();
-            }
-
-            [[nodiscard]] const std::string& PointSymbol() const {return rule.at(point);}
-
-            [[nodiscard]] std::string GetFullString() const;
-
-            [[nodiscard]] std::string to_string() const;
-
-        };
-
-        SLR1(io_buffer::TextSourceBuffer *input_file, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true) :
-                SLR1(grammar::GrammarParser(input_file), tokenizer, augment_grammar) {}
-
-        SLR1(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true);
+        SLR1(io_buffer::TextSourceBuffer *input_file, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true,
+             unsigned threads=1) :
+                SLR1(grammar::GrammarParser(input_file), tokenizer, augment_grammar, threads) {}
+
+        /*!
+         * @param threads Number of threads building the automaton of the table, 0 uses every available core.
+         */
+        SLR1(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar=true,
+             unsigned threads=1);
         bool Parse(bool verbose) override;
 
     protected:
-        using ItemSet = std::set<Item>;
         using cell = std::pair<char, int>;
 
         int states_number_=0;
 
         void PrintParsingTable() override;
 
-        ItemSet ItemsClosure(const Item &item_input, ItemSet &calculated);
-
-        ItemSet ItemsClosure(const ItemSet &input_items);
-
-        ItemSet goTo(const ItemSet &input_items, const std::string &input_symbol);
-
-        virtual void CreateParsingTable(const std::vector<std::tuple<std::string, ItemSet, ItemSet>> &states_function);
+        /*!
+         * @brief Fills #function_ from the states of @p automaton, @p accept_item accepts on "$".
+         */
+        virtual void CreateParsingTable(const LR0Automaton &automaton, PackedItem accept_item);
 
-        void ThrowConflictError(Conflict c, const std::pair<ItemSet, int> &print_obj, const std::set<int> &rule_set,
+        void ThrowConflictError(Conflict c, const LR0Automaton &automaton, int state, const std::set<int> &rule_set,
                                 const std::string &symbol = "");
     };
 
@@ -0,0 +1,90 @@
+#ifndef COMPILER_INCREMENTAL_LR_H
+#define COMPILER_INCREMENTAL_LR_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "analyzers/incremental_lexer.h"
+#include "parsers/grammar_utils/grammar_array.h"
+#include "parsers/parser_algorithms/lr_parser.h"
+
+namespace compiler::parsers {
+
+    /*!
+     * @brief LR driver that keeps the parse tree of a document and reuses its subtrees after an edit.
+     * @details Works with the table of any LR driver (LR0, SLR1, LR1 or LALR) on the token stream of an
+     * analyzers::IncrementalLexer. Every node records the state on top of the stack when it was pushed. After an
+     * edit the old tree is read again as input, left to right. When the parser would shift a token that starts an
+     * old subtree, and the subtree is outside the edited tokens, its lookahead token (the one after it) is
+     * unchanged, and it was pushed on the same state, the parser would build the same subtree again, so the whole
+     * subtree is shifted through a goto instead. Subtrees that can't be reused are broken into their children.
+     */
+    class IncrementalLR {
+    public:
+        struct Node;
+
+        using NodePtr = std::shared_ptr<const Node>;
+
+        /*!
+         * @brief Node of the parse tree.
+         * @details Nodes don't store their position, only the number of tokens they cover, so a subtree stays
+         * valid wherever an edit moves it. The tokens of a node are found by adding the sizes of its left siblings.
+         */
+        struct Node {
+            std::string symbol;  //!< Grammar symbol of the node.
+            int rule;            //!< Index of the rule reduced to build the node, -1 for terminals.
+            int state;           //!< State on top of the stack when the node was pushed.
+            std::size_t tokens;  //!< Number of tokens covered by the node.
+            std::vector<NodePtr> children;
+        };
+
+        /*!
+         * @brief Copies the parsing table and the grammar of @p parser.
+         */
+        explicit IncrementalLR(const Parser<LRTable> &parser);
+
+        /*!
+         * @brief Parses @p tokens from scratch.
+         * @return True if @p tokens are accepted, root() is then their parse tree.
+         */
+        bool Parse(const std::vector<analyzers::TokenSpan> &tokens);
+
+        /*!
+         * @brief Parses @p tokens, reusing the tree of the previous call where @p edit didn't change the tokens.
+         * @param tokens Token stream after the edit.
+         * @param edit Tokens replaced since the previous call, as returned by analyzers::IncrementalLexer::Edit().
+         * @return True if @p tokens are accepted. If the previous call failed, the tokens are parsed from scratch.
+         */
+        bool Reparse(const std::vector<analyzers::TokenSpan> &tokens, const analyzers::TokenEdit &edit);
+
+        [[nodiscard]] const NodePtr &root() const { return root_; }
+
+        /*!
+         * @brief Gets the number of subtrees reused by the last call.
+         */
+        [[nodiscard]] std::size_t reused_nodes() const { return reused_nodes_; }
+
+    private:
+        struct Pending {
+            NodePtr node;
+            std::size_t first; //!< Index of the first token of the node before the edit.
+        };
+
+        LRTable function_;
+        grammar::GrammarArray grammar_;
+        NodePtr root_;
+        std::size_t reused_nodes_ = 0;
+
+        [[nodiscard]] std::string Lookahead(const std::vector<analyzers::TokenSpan> &tokens, std::size_t position) const;
+
+        NodePtr NextSubtree(std::vector<Pending> &pending, const analyzers::TokenEdit &edit, std::size_t position,
+                            int state) const;
+
+        bool Run(const std::vector<analyzers::TokenSpan> &tokens, const analyzers::TokenEdit &edit);
+    };
+} // namespace compiler::parsers
+
+#endif //COMPILER_INCREMENTAL_LR_H
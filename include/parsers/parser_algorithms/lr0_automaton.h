@@ -0,0 +1,122 @@
+#ifndef COMPILER_LR0_AUTOMATON_H
+#define COMPILER_LR0_AUTOMATON_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "parsers/grammar_utils/frozen_grammar.h"
+
+namespace compiler::parsers {
+
+    /*!
+     * @brief LR(0) item packed in one integer: the rule index in the high half and the dot position in the low half.
+     * @details Rule indexes are the ones of grammar::FrozenGrammar, so comparing and hashing items costs one integer
+     * operation.
+     */
+    using PackedItem = std::uint64_t;
+
+    inline PackedItem PackItem(int rule, int dot) { return (PackedItem) rule << 32 | (std::uint32_t) dot; }
+
+    inline int ItemRule(PackedItem item) { return (int) (item >> 32); }
+
+    inline int ItemDot(PackedItem item) { return (int) (std::uint32_t) item; }
+
+    /*!
+     * @return The symbol after the dot of @p item, or -1 if the item is complete.
+     */
+    grammar::FrozenGrammar::Symbol NextSymbol(const grammar::FrozenGrammar &grammar, PackedItem item);
+
+    /*!
+     * @brief Gets @p item as in ".- A -> a . b".
+     */
+    std::string ItemString(const grammar::FrozenGrammar &grammar, PackedItem item);
+
+    /*!
+     * @brief Kernel items of a state, sorted, with their hash computed once.
+     */
+    struct Kernel {
+        std::vector<PackedItem> items;
+        std::size_t hash = 0;
+
+        Kernel() = default;
+
+        explicit Kernel(std::vector<PackedItem> items);
+
+        bool operator==(const Kernel &obj) const { return hash == obj.hash && items == obj.items; }
+    };
+
+    struct KernelHash {
+        std::size_t operator()(const Kernel &kernel) const { return kernel.hash; }
+    };
+
+    /*!
+     * @brief Canonical collection of LR(0) item sets of a grammar, the automaton shared by the LR0 and SLR1 tables.
+     * @details A state is identified by its kernel, the items reached by a goto plus the initial item, and its
+     * closure is computed only when asked for. States are found through a hash map of kernels and numbered in the
+     * order they are discovered, state 0 being the initial one. With several threads the states are explored by a
+     * ParallelCollection, which numbers them the same way.
+     */
+    class LR0Automaton {
+    public:
+        using Symbol = grammar::FrozenGrammar::Symbol;
+
+        struct State {
+            Kernel kernel;
+            std::vector<std::pair<Symbol, int>> transitions; //!< Goto of every symbol after a dot, sorted by symbol.
+        };
+
+        /*!
+         * @brief Builds every state reachable from the item @p start_rule -> . , dot at 0.
+         * @param threads Number of threads exploring the states, 0 uses every available core.
+         */
+        LR0Automaton(const grammar::FrozenGrammar &grammar, int start_rule, unsigned threads = 1);
+
+        [[nodiscard]] int size() const { return (int) states_.size(); }
+
+        [[nodiscard]] const State &operator[](int state) const { return states_[state]; }
+
+        /*!
+         * @return The state reached from @p state with @p symbol, or -1 if there is none.
+         */
+        [[nodiscard]] int Goto(int state, Symbol symbol) const;
+
+        /*!
+         * @brief Gets the kernel items of @p state followed by the items added by its closure.
+         */
+        [[nodiscard]] std::vector<PackedItem> Closure(int state) const;
+
+        [[nodiscard]] Symbol NextSymbol(PackedItem item) const { return parsers::NextSymbol(*grammar_, item); }
+
+        [[nodiscard]] std::string ItemString(PackedItem item) const { return parsers::ItemString(*grammar_, item); }
+
+        [[nodiscard]] const grammar::FrozenGrammar &grammar() const { return *grammar_; }
+
+    private:
+        const grammar::FrozenGrammar *grammar_;
+        std::vector<State> states_;
+        std::unordered_map<Kernel, int, KernelHash> state_ids_;
+
+        /*!
+         * @brief Scratch buffers of the construction, one per thread.
+         */
+        struct BuildBuffers {
+            std::vector<PackedItem> items;
+            std::vector<char> added;
+            std::vector<std::vector<PackedItem>> advanced; //!< Advanced items of every symbol.
+            std::vector<Symbol> symbols;
+        };
+
+        void Closure(std::vector<PackedItem> &items, std::vector<char> &added) const;
+
+        /*!
+         * @brief Leaves in @p buffers the symbols after a dot in the closure of @p kernel, sorted, and the items
+         * they advance to.
+         */
+        void Advance(const Kernel &kernel, BuildBuffers &buffers) const;
+    };
+} // namespace compiler::parsers
+
+#endif //COMPILER_LR0_AUTOMATON_H
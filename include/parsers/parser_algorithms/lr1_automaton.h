@@ -0,0 +1,166 @@
+#ifndef COMPILER_LR1_AUTOMATON_H
+#define COMPILER_LR1_AUTOMATON_H
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "parsers/grammar_utils/grammar_array.h"
+#include "parsers/grammar_utils/terminal_set.h"
+#include "parsers/parser_algorithms/lr0_automaton.h"
+
+namespace compiler::parsers {
+
+    /*!
+     * @brief LR(0) item with the set of its lookahead terminals.
+     */
+    using LR1Item = std::pair<PackedItem, grammar::TerminalSet>;
+
+    /*!
+     * @brief Kernel items of an LR(1) state, sorted by item with one lookahead set per LR(0) item, and their hash.
+     */
+    struct LR1Kernel {
+        std::vector<LR1Item> items;
+        std::size_t hash = 0;
+
+        LR1Kernel() = default;
+
+        /*!
+         * @brief Sorts @p items and merges the lookaheads of equal LR(0) items.
+         */
+        explicit LR1Kernel(std::vector<LR1Item> items);
+
+        bool operator==(const LR1Kernel &obj) const { return hash == obj.hash && items == obj.items; }
+    };
+
+    struct LR1KernelHash {
+        std::size_t operator()(const LR1Kernel &kernel) const { return kernel.hash; }
+    };
+
+    /*!
+     * @brief Collection of LR(1) item sets of a grammar, the automaton of the LR1 and PagerLR1 tables.
+     * @details States are stored and identified only by their kernel, found through a hash map, and numbered in the
+     * order they are discovered, state 0 being the initial one. The closure of a kernel is computed when its
+     * state is expanded, with one lookahead set per variable propagated to a fixed point. Its reductions are kept
+     * with the state, so the closure isn't needed again to build the table.
+     *
+     * With Construction::kPager a new kernel is merged into a state of the same LR(0) core when the two are weakly
+     * compatible (Pager, 1977), which can't add a conflict the canonical collection doesn't have. A state whose
+     * lookaheads grew by a merge is expanded again, to carry them to its reductions and successors, a successor they
+     * are no longer compatible with being replaced by another state. The states nothing reaches anymore are dropped
+     * once the collection is built.
+     *
+     * The canonical collection can be explored by several threads with a ParallelCollection, which numbers the
+     * states the same way. Pager's construction depends on the order states are merged in, so it uses one thread.
+     */
+    class LR1Automaton {
+    public:
+        using Symbol = grammar::FrozenGrammar::Symbol;
+
+        struct State {
+            LR1Kernel kernel;
+            std::vector<std::pair<Symbol, int>> transitions; //!< Goto of every symbol after a dot, sorted by symbol.
+            std::vector<std::pair<int, grammar::TerminalSet>> reductions; //!< Complete rules and their lookaheads.
+        };
+
+        enum class Construction {
+            kCanonical, //!< One state per distinct kernel.
+            kPager      //!< Weakly compatible kernels of the same core share a state.
+        };
+
+        /*!
+         * @brief Builds every state reachable from the item @p start_rule -> . , dot at 0, with lookahead "$".
+         * @param threads Number of threads exploring the states of kCanonical, 0 uses every available core.
+         */
+        LR1Automaton(grammar::GrammarArray &grammar, int start_rule,
+                     Construction construction = Construction::kCanonical, unsigned threads = 1);
+
+        [[nodiscard]] int size() const { return (int) states_.size(); }
+
+        [[nodiscard]] const State &operator[](int state) const { return states_[state]; }
+
+        /*!
+         * @return The state reached from @p state with @p symbol, or -1 if there is none.
+         */
+        [[nodiscard]] int Goto(int state, Symbol symbol) const;
+
+        /*!
+         * @brief Gets the kernel items of @p state followed by the items added by its closure.
+         */
+        [[nodiscard]] std::vector<LR1Item> Closure(int state) const;
+
+        [[nodiscard]] const grammar::FrozenGrammar &grammar() const { return *grammar_; }
+
+    private:
+        const grammar::FrozenGrammar *grammar_;
+        Construction construction_;
+        std::vector<char> nullable_;                  //!< Nullable of every variable index.
+        std::vector<grammar::TerminalSet> first_;     //!< First of every variable index.
+        std::vector<State> states_;
+        std::unordered_map<LR1Kernel, int, LR1KernelHash> state_ids_;      //!< States of kCanonical by kernel.
+        std::unordered_map<Kernel, std::vector<int>, KernelHash> cores_;  //!< States of kPager by LR(0) core.
+
+        /*!
+         * @brief Scratch buffers of Closure(), reused between states.
+         */
+        struct ClosureBuffers {
+            std::vector<grammar::TerminalSet> lookaheads; //!< Lookaheads of the rules of every variable index.
+            std::vector<char> added;
+            std::vector<int> order;                       //!< Added variables, in the order they were added.
+            std::vector<int> pending;
+            std::vector<char> queued;
+        };
+
+        /*!
+         * @brief Scratch buffers of the construction.
+         */
+        struct BuildBuffers {
+            ClosureBuffers closure;
+            std::vector<LR1Item> items;
+            std::vector<std::vector<LR1Item>> advanced; //!< Advanced items of every symbol.
+            std::vector<Symbol> symbols;
+            std::vector<int> pending;                   //!< States to expand, in the order they were queued.
+            std::vector<char> queued;
+        };
+
+        void Closure(const LR1Kernel &kernel, ClosureBuffers &buffers, std::vector<LR1Item> &items) const;
+
+        /*!
+         * @brief Stores the reductions of the closure of @p state and leaves in @p buffers the symbols after a dot,
+         * sorted, and the items they advance to.
+         */
+        void Advance(State &state, BuildBuffers &buffers) const;
+
+        /*!
+         * @brief Advances @p state. The first time, finds or creates its successors, afterwards merges their new
+         * kernels into them.
+         */
+        void Expand(int state, BuildBuffers &buffers);
+
+        /*!
+         * @return The state of @p kernel, created if there is none it can be merged into.
+         */
+        int FindState(LR1Kernel kernel, BuildBuffers &buffers);
+
+        /*!
+         * @brief Merges the lookaheads of @p kernel, of the same core, into @p state and queues it if they grew.
+         */
+        void MergeInto(int state, const LR1Kernel &kernel, BuildBuffers &buffers);
+
+        static void Queue(int state, BuildBuffers &buffers);
+
+        /*!
+         * @brief Drops the states of kPager left unreachable by a replaced successor, renumbering the others.
+         */
+        void RemoveUnreachable();
+
+        /*!
+         * @brief Pager's weak compatibility test of two kernels with the same core: merging them can't create a
+         * reduce/reduce conflict that neither has.
+         */
+        static bool WeaklyCompatible(const LR1Kernel &a, const LR1Kernel &b);
+    };
+} // namespace compiler::parsers
+
+#endif //COMPILER_LR1_AUTOMATON_H
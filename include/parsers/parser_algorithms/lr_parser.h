@@ -0,0 +1,146 @@
+#ifndef COMPILER_LR_PARSER_H
+#define COMPILER_LR_PARSER_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "analyzers/lexical_analyzer.h"
+#include "parsers/grammar_utils/grammar_array.h"
+#include "parsers/parser_algorithms/conflict_man.h"
+#include "parsers/parser_algorithms/parser.h"
+#include "parsers/parser_algorithms/syntax_tree.h"
+
+namespace compiler::parsers {
+
+    using LRTable = std::map<std::pair<int, std::string>, std::pair<char, int>>; //!< Table of the LR drivers.
+
+    /*!
+     * @brief Contiguous range of semantic values, the values of the right side of a reduced rule.
+     */
+    template<typename T>
+    class ValueSpan {
+    private:
+        T *data_;
+        std::size_t size_;
+    public:
+        ValueSpan(T *data, std::size_t size) : data_(data), size_(size) {}
+
+        [[nodiscard]] std::size_t size() const { return size_; }
+
+        [[nodiscard]] bool empty() const { return size_ == 0; }
+
+        T &operator[](std::size_t index) const { return data_[index]; }
+
+        T *begin() const { return data_; }
+
+        T *end() const { return data_ + size_; }
+    };
+
+    /*!
+     * @brief Base of the LR drivers (LR0, SLR1, LR1 and LALR), which only differ in how they build their table.
+     */
+    class LRParser : public Parser<LRTable>,
+                     public ConflictManager {
+    private:
+        std::vector<std::pair<std::string, std::size_t>> reductions_; //!< Variable and length of every rule, "#" (epsilon) not counted.
+
+        const std::pair<std::string, std::size_t> &Reduction(int rule);
+
+        std::string Lookahead(const analyzers::Token &token) const {
+            return grammar_.terminals().count(token.token_name) ? token.token_name : token.lexeme;
+        }
+
+    public:
+        LRParser(analyzers::LexicalAnalyzer &tokenizer, grammar::GrammarArray grammar) :
+                Parser(tokenizer, std::move(grammar)) {}
+
+        /*!
+         * @brief Parses the input of the tokenizer computing a semantic value for every symbol.
+         * @details Semantic values are kept in a stack aligned with the state stack. The callbacks are resolved at
+         * compile time, @p actions must provide:
+         * - a default constructible and movable type Actions::Value;
+         * - Value Shift(const analyzers::Token &token), the value of a shifted token;
+         * - Value Reduce(int rule, ValueSpan<Value> children), the value of the variable of rule @p rule, with
+         * index as in grammar::GrammarArray::GetRuleFromIndex(), from the values of its right side. The values in
+         * @p children may be moved from.
+         * @param result Value of the axiom if the input is accepted.
+         * @return True if the input is accepted.
+         */
+        template<typename Actions>
+        bool Translate(Actions &actions, typename Actions::Value &result);
+
+        /*!
+         * @brief Parses the input of the tokenizer and builds its concrete syntax tree in @p tree.
+         * @details Every shift adds a leaf and every reduction a node whose children are copied from the value
+         * stack into one contiguous array of the arena of @p tree.
+         * @return True if the input is accepted.
+         */
+        bool ParseTree(SyntaxTree &tree);
+
+        /*!
+         * @brief Removes the reductions by unit rules A -> B, B a variable, from the table.
+         * @details A state whose only action is reducing A -> B is reached by a goto on B from a state p and goes
+         * back to p to take its goto on A, so the goto on B of p is redirected to that state, following chains of
+         * unit rules, and the bypassed states are removed. Every lookahead accepted before is still accepted and
+         * errors are detected before the same shift.
+         * @attention Translate() and ParseTree() don't see the removed reductions, use it only when unit rules have
+         * no semantic actions.
+         * @return Number of redirected gotos.
+         */
+        int EliminateUnitReductions();
+
+    protected:
+        /*!
+         * @brief Resolves the conflict between shifting @p terminal to @p next_state and the reduction on it in the
+         * table, with their declared precedences as in yacc.
+         * @details The higher precedence wins. At the same level a left associative terminal reduces, a right
+         * associative one shifts and a %nonassoc one is removed from the table, so it is a syntax error.
+         * @return False if the terminal or the rule has no precedence, the conflict stays.
+         */
+        bool ResolveShiftReduce(const grammar::FrozenGrammar &grammar, int state,
+                                grammar::FrozenGrammar::Symbol terminal, int next_state);
+    };
+
+    template<typename Actions>
+    bool LRParser::Translate(Actions &actions, typename Actions::Value &result) {
+        using Value = typename Actions::Value;
+        std::vector<int> states = {0};
+        std::vector<Value> values(1);
+
+        auto current_token = tokenizer_.yylex();
+        std::string saver = Lookahead(current_token);
+        while (true) {
+            auto action = function_.find({states.back(), saver});
+            if (action == function_.end())
+                return false;
+
+            if (action->second.first == 'a') {
+                result = std::move(values.back());
+                return true;
+            } else if (action->second.first == 's') {
+                values.push_back(actions.Shift(current_token));
+                states.push_back(action->second.second);
+                current_token = tokenizer_.yylex();
+                saver = Lookahead(current_token);
+            } else if (action->second.first == 'r') {
+                const auto &[variable, rule_size] = Reduction(action->second.second);
+                Value value = actions.Reduce(action->second.second,
+                                             ValueSpan<Value>(values.data() + values.size() - rule_size, rule_size));
+                states.resize(states.size() - rule_size);
+                values.erase(values.end() - (long) rule_size, values.end());
+
+                auto go_to = function_.find({states.back(), variable});
+                if (go_to == function_.end() || go_to->second.first != 'g')
+                    return false;
+                states.push_back(go_to->second.second);
+                values.push_back(std::move(value));
+            } else {
+                return false;
+            }
+        }
+    }
+} // namespace compiler::parsers
+
+#endif //COMPILER_LR_PARSER_H
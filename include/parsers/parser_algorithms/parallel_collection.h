@@ -0,0 +1,165 @@
+#ifndef COMPILER_PARALLEL_COLLECTION_H
+#define COMPILER_PARALLEL_COLLECTION_H
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace compiler::parsers {
+
+    /*!
+     * @brief Builds a collection of item sets with several threads, for LR0Automaton and LR1Automaton.
+     * @details Every worker expands the states of its own frontier, newest first, and steals the oldest state of
+     * another frontier when its own is empty. States are deduplicated by kernel in a map split into shards, each
+     * with its own lock, and get a provisional id from their shard. Once every state is expanded they are
+     * renumbered breadth first from the initial one, following transitions in symbol order, which is the order a
+     * single thread discovers them in, so the result doesn't depend on the scheduling.
+     * @tparam State Aggregate with a kernel and its transitions, a vector of symbol and state pairs.
+     * @tparam KernelHash Hash of the kernels.
+     */
+    template<typename State, typename KernelHash>
+    class ParallelCollection {
+    public:
+        using Kernel = decltype(State::kernel);
+
+        /*!
+         * @brief Builds every state reachable from @p initial.
+         * @param threads Number of worker threads, 0 uses every available core.
+         * @param expand Called as expand(state, successor, worker) once per state, on worker number @p worker, it
+         * fills the transitions of @p state, sorted by symbol, with the ids returned by successor(kernel).
+         */
+        template<typename Expand>
+        static std::vector<State> Build(Kernel initial, unsigned threads, Expand expand) {
+            if (threads == 0)
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            ParallelCollection collection(threads);
+            int initial_id = collection.Insert(std::move(initial), 0);
+
+            std::vector<std::thread> workers;
+            for (unsigned worker = 1; worker < threads; ++worker)
+                workers.emplace_back([&collection, &expand, worker] { collection.Work(expand, worker); });
+            collection.Work(expand, 0);
+            for (auto &worker : workers)
+                worker.join();
+            return collection.Renumber(initial_id);
+        }
+
+    private:
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<Kernel, int, KernelHash> ids;
+            std::deque<State> states; //!< Never moves its elements, so they are expanded outside of the lock.
+        };
+
+        struct Frontier {
+            std::mutex mutex;
+            std::deque<int> ids;
+        };
+
+        std::vector<Shard> shards_;
+        std::vector<Frontier> frontiers_;
+        std::atomic<int> pending_{0}; //!< States inserted and not expanded yet.
+
+        explicit ParallelCollection(unsigned threads) : shards_(4 * threads), frontiers_(threads) {}
+
+        [[nodiscard]] int shard_count() const { return (int) shards_.size(); }
+
+        State &At(int id) {
+            Shard &shard = shards_[id % shard_count()];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            return shard.states[id / shard_count()];
+        }
+
+        /*!
+         * @return The provisional id of the state of @p kernel, queued on the frontier of @p worker if it is new.
+         */
+        int Insert(Kernel kernel, unsigned worker) {
+            int shard_id = (int) (KernelHash()(kernel) % shards_.size());
+            Shard &shard = shards_[shard_id];
+            int id;
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                int new_id = (int) shard.states.size() * shard_count() + shard_id;
+                auto [entry, inserted] = shard.ids.emplace(std::move(kernel), new_id);
+                if (!inserted)
+                    return entry->second;
+                shard.states.emplace_back();
+                shard.states.back().kernel = entry->first;
+                id = entry->second;
+            }
+            ++pending_;
+            std::lock_guard<std::mutex> lock(frontiers_[worker].mutex);
+            frontiers_[worker].ids.push_back(id);
+            return id;
+        }
+
+        bool Pop(unsigned worker, int &id) {
+            {
+                std::lock_guard<std::mutex> lock(frontiers_[worker].mutex);
+                if (!frontiers_[worker].ids.empty()) {
+                    id = frontiers_[worker].ids.back();
+                    frontiers_[worker].ids.pop_back();
+                    return true;
+                }
+            }
+            for (std::size_t i = 1; i < frontiers_.size(); ++i) {
+                Frontier &victim = frontiers_[(worker + i) % frontiers_.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.ids.empty()) {
+                    id = victim.ids.front();
+                    victim.ids.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template<typename Expand>
+        void Work(Expand &expand, unsigned worker) {
+            auto successor = [this, worker](Kernel kernel) { return Insert(std::move(kernel), worker); };
+            // A state is counted as pending until its successors are inserted, so no work is left at 0.
+            while (pending_ > 0) {
+                int id;
+                if (!Pop(worker, id)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                expand(At(id), successor, worker);
+                --pending_;
+            }
+        }
+
+        std::vector<State> Renumber(int initial_id) {
+            std::size_t capacity = 0;
+            for (const auto &shard : shards_)
+                capacity = std::max(capacity, shard.states.size() * shards_.size());
+            std::vector<int> number(capacity, -1);
+            std::vector<int> order = {initial_id};
+            number[initial_id] = 0;
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                for (const auto &transition : At(order[i]).transitions) {
+                    if (number[transition.second] < 0) {
+                        number[transition.second] = (int) order.size();
+                        order.push_back(transition.second);
+                    }
+                }
+            }
+
+            std::vector<State> states;
+            states.reserve(order.size());
+            for (int id : order) {
+                states.push_back(std::move(At(id)));
+                for (auto &transition : states.back().transitions)
+                    transition.second = number[transition.second];
+            }
+            return states;
+        }
+    };
+} // namespace compiler::parsers
+
+#endif //COMPILER_PARALLEL_COLLECTION_H
@@ -22,6 +22,10 @@ namespace compiler::parsers{
         tokenizer_(tokenizer), grammar_(std::move(grammar)) {}
         virtual bool Parse(bool verbose) = 0;
         bool Parse(){ return Parse(false); }
+
+        [[nodiscard]] const T &parsing_table() const { return function_; }
+
+        [[nodiscard]] const grammar::GrammarArray &grammar_array() const { return grammar_; }
     };
 } // namespace compiler::parsers
 
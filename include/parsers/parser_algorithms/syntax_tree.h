@@ -0,0 +1,122 @@
+#ifndef COMPILER_SYNTAX_TREE_H
+#define COMPILER_SYNTAX_TREE_H
+
+#include <functional>
+#include <memory>
+#include <new>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "analyzers/lexical_analyzer.h"
+
+namespace compiler::parsers {
+
+    /*!
+     * @brief Bump-pointer allocator.
+     * @details Objects are placed one after the other in large blocks and are all released together, so building a
+     * tree costs no allocation per node. Destructors are never run, so only trivially destructible types can be
+     * allocated.
+     */
+    class Arena {
+    private:
+        static constexpr std::size_t kBlockSize = 1 << 16; //!< Size in bytes of every block.
+
+        std::vector<std::unique_ptr<char[]>> blocks_;
+        char *next_ = nullptr;     //!< First free byte of the last block.
+        std::size_t available_ = 0; //!< Free bytes left in the last block.
+
+        void *Allocate(std::size_t size, std::size_t alignment);
+
+    public:
+        Arena() = default;
+
+        Arena(const Arena &) = delete;
+
+        Arena &operator=(const Arena &) = delete;
+
+        /*!
+         * @brief Allocates @p count contiguous value-initialized objects.
+         * @return The first object, or nullptr if @p count is 0.
+         */
+        template<typename T>
+        T *Allocate(std::size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+            if (count == 0)
+                return nullptr;
+            T *objects = static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+            for (std::size_t i = 0; i < count; ++i)
+                new(objects + i) T();
+            return objects;
+        }
+
+        /*!
+         * @brief Releases every object.
+         */
+        void Clear();
+    };
+
+    /*!
+     * @brief Node of a concrete syntax tree.
+     * @details Nodes live in the Arena of their SyntaxTree. A node doesn't copy its text, it refers to the range of
+     * SyntaxTree::tokens() it covers, and the children of a node are stored contiguously.
+     */
+    struct SyntaxNode {
+        std::string_view symbol;    //!< Grammar symbol of the node, owned by the SyntaxTree.
+        int rule = -1;              //!< Index of the rule that derived the node, -1 for terminals.
+        std::size_t first_token = 0; //!< Index of the first token covered by the node.
+        std::size_t token_count = 0; //!< Number of tokens covered by the node.
+        SyntaxNode *children = nullptr;
+        std::size_t child_count = 0;
+
+        [[nodiscard]] const SyntaxNode *begin() const { return children; }
+
+        [[nodiscard]] const SyntaxNode *end() const { return children + child_count; }
+    };
+
+    /*!
+     * @brief Concrete syntax tree built by the ParseTree() method of the parsers.
+     */
+    class SyntaxTree {
+    private:
+        Arena arena_;
+        std::vector<analyzers::Token> tokens_;
+        std::set<std::string, std::less<>> symbols_; //!< Grammar symbols referred to by the nodes.
+        const SyntaxNode *root_ = nullptr;
+
+    public:
+        /*!
+         * @brief Releases every node and token, so the tree can be built again.
+         */
+        void Clear();
+
+        /*!
+         * @brief Gets a copy of @p symbol owned by the tree, every node with the same symbol shares it.
+         */
+        std::string_view Intern(std::string_view symbol);
+
+        /*!
+         * @brief Appends @p token to the tokens of the tree.
+         * @return The index of the token.
+         */
+        std::size_t AddToken(analyzers::Token token);
+
+        /*!
+         * @brief Allocates @p count contiguous nodes in the arena of the tree.
+         */
+        SyntaxNode *NewNodes(std::size_t count) { return arena_.Allocate<SyntaxNode>(count); }
+
+        void set_root(const SyntaxNode *root) { root_ = root; }
+
+        /*!
+         * @return The root of the tree, or nullptr if the input was rejected.
+         */
+        [[nodiscard]] const SyntaxNode *root() const { return root_; }
+
+        [[nodiscard]] const std::vector<analyzers::Token> &tokens() const { return tokens_; }
+    };
+} // namespace compiler::parsers
+
+#endif //COMPILER_SYNTAX_TREE_H
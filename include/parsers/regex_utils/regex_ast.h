@@ -0,0 +1,80 @@
+/*!
+ * @file regex_ast.h
+ * @brief Syntax tree of regular expressions.
+ * @details RegexParser builds a tree for every rule, Simplify() rewrites it into an equivalent tree with fewer
+ * nodes and BuildNFA() applies the Thompson construction to the result.
+ */
+
+#ifndef COMPILER_REGEX_AST_H
+#define COMPILER_REGEX_AST_H
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "automata/nfa.h"
+
+namespace compiler::regex {
+
+    enum class RegexNodeType {
+        EMPTY,            // Empty string
+        CLASS,            // One byte of a set
+        CONCAT,           // Children one after another
+        UNION,            // Any of the children
+        STAR,             // Zero or more times the child
+        PLUS,             // One or more times the child
+        OPTIONAL          // Zero or one time the child
+    };
+
+    struct RegexNode;
+
+    using RegexNodePtr = std::shared_ptr<const RegexNode>;
+
+    /*!
+     * @brief Immutable node of a regular expression.
+     * @details Nodes are never modified once built, so a subtree can be shared by several parents, e.g. every copy
+     * of a {m,n} repetition or every use of a named definition points to the same subtree.
+     */
+    struct RegexNode {
+        RegexNodeType type;
+        std::set<char> bytes;              //!< Bytes of a CLASS node.
+        std::vector<RegexNodePtr> children;
+        std::size_t states;                //!< Number of states of the Thompson NFA of the node.
+
+        static RegexNodePtr Empty();
+
+        static RegexNodePtr Class(std::set<char> bytes);
+
+        static RegexNodePtr Concat(std::vector<RegexNodePtr> children);
+
+        static RegexNodePtr Union(std::vector<RegexNodePtr> children);
+
+        /*!
+         * @param type STAR, PLUS or OPTIONAL.
+         */
+        static RegexNodePtr Closure(RegexNodeType type, RegexNodePtr child);
+    };
+
+    /*!
+     * @brief Checks whether two trees have the same structure.
+     */
+    bool Equal(const RegexNodePtr &a, const RegexNodePtr &b);
+
+    /*!
+     * @brief Rewrites @p node into an equivalent tree with fewer nodes.
+     * @details The rewrites are applied bottom-up:
+     * - nested concatenations and unions are flattened, and empty strings are removed from concatenations,
+     * - alternatives with a common first factor are factored, ab|ac = a(b|c),
+     * - single byte alternatives are merged into one class, a|[bc] = [abc],
+     * - an empty alternative makes the union optional, a|() = a?,
+     * - nested closures are collapsed, (a*)* = (a+)* = (a?)* = a*, and x x* = x+.
+     */
+    RegexNodePtr Simplify(const RegexNodePtr &node);
+
+    /*!
+     * @brief Builds the Thompson NFA of @p node, with fresh states for every occurrence of a shared subtree.
+     */
+    automata::NFA BuildNFA(const RegexNodePtr &node);
+} //namespace compiler::regex
+
+#endif //COMPILER_REGEX_AST_H
@@ -0,0 +1,27 @@
+/*!
+ * @file regex_dfa.h
+ * @brief Direct construction of a DFA from regular expression trees.
+ */
+
+#ifndef COMPILER_REGEX_DFA_H
+#define COMPILER_REGEX_DFA_H
+
+#include <vector>
+
+#include "automata/dfa.h"
+#include "parsers/regex_utils/regex_parser.h"
+
+namespace compiler::regex {
+
+    /*!
+     * @brief Builds the DFA of the lexical union of @p rules without an intermediate NFA.
+     * @details Uses the followpos construction (Aho, Sethi and Ullman): every byte class in the trees is a
+     * position, every rule ends with a marker position, and every DFA state is a set of positions. The transitions
+     * of a state follow the followpos sets of its positions, so no epsilon closure is ever computed. The result is
+     * equivalent to NFA::CalculateLexicalUnion(...).ToDFA() on the automata of the same rules, the index of every rule
+     * is its rule id, so states where several rules end get the token of the last one.
+     */
+    automata::DFA BuildDFA(const std::vector<RegexRule> &rules);
+} //namespace compiler::regex
+
+#endif //COMPILER_REGEX_DFA_H
@@ -1,44 +1,125 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include <map>
+#include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "automata/nfa.h"
+#include "parsers/regex_utils/regex_ast.h"
 #include "parsers/regex_utils/regex_scanner.h"
+#include "parsers/regex_utils/utf8.h"
 
 namespace compiler::regex {
 
+    /*!
+     * @brief Encoding of the input recognized by the generated automata.
+     */
+    enum class Encoding {
+        BYTES,            // Every byte 1-255 is a character
+        UTF8              // Classes, complements and . match whole UTF-8 sequences
+    };
+
+    /*!
+     * @brief Rule of a specification.
+     */
+    struct RegexRule {
+        RegexNodePtr regex;           //!< Simplified expression of the rule.
+        std::string action;           //!< Token name of the lexemes matched by the rule.
+        std::set<std::string> modes;  //!< Start conditions of the rule, empty for every mode.
+    };
+
     class RegexParser {
-        std::set<char> any_char_;
+        static const std::size_t kMaxRepetitionStates = 1 << 16; //!< Limit of NFA states expanded by {m,n}.
+
+        Encoding encoding_;
+        std::vector<CodePointRange> any_char_;
         RegexScanner regex_scanner_;
-        std::vector <automata::NFA> lexical_nfa_;
+        std::vector<RegexRule> rules_;
+        bool parsed_ = false;
+        std::set<std::string> modes_ = {kInitialMode};   //!< Every start condition found in the specification.
+        std::map<std::string, RegexNodePtr> definitions_; //!< Expression of every named definition.
 
         void Machine();
 
-        automata::NFA Rule();
+        static bool IsName(const std::string &text);
+
+        bool HasDefinitions();
+
+        void Definitions();
+
+        bool IsExpansion();
+
+        RegexNodePtr Expansion();
+
+        RegexRule Rule();
 
-        void Expr(automata::NFA &automata);
+        bool IsStartConditions();
 
-        void CatExpr(automata::NFA &automata);
+        void StartConditions(std::set<std::string> &modes);
+
+        RegexNodePtr Expr();
+
+        RegexNodePtr CatExpr();
 
         static bool isConcatenable(RegexToken);
 
-        void Factor(automata::NFA &automata);
+        RegexNodePtr Factor();
+
+        int Count();
+
+        RegexNodePtr Repetition(const RegexNodePtr &node);
+
+        RegexNodePtr Term();
 
-        void Term(automata::NFA &automata);
+        void Dash(std::vector<CodePointRange> &ranges);
 
-        void Dash(std::set<char> &automata);
+        char32_t ReadChar();
+
+        [[nodiscard]] RegexNodePtr CreateClass(const std::vector<CodePointRange> &ranges) const;
+
+        [[nodiscard]] char32_t max_char() const { return encoding_ == Encoding::UTF8 ? kMaxCodePoint : kMaxByte; }
 
     public:
-        explicit RegexParser(RegexScanner scanner) : regex_scanner_(std::move(scanner)) {
-            for (int i = ' '; i <= '}'; i++) any_char_.insert(i);
+        /*!
+         * @param scanner Scanner of the specification.
+         * @param encoding Encoding of the input. Literal characters are always matched byte by byte, the encoding
+         * decides whether character classes, their complements and . work on bytes or on UTF-8 code points.
+         */
+        explicit RegexParser(RegexScanner scanner, Encoding encoding = Encoding::UTF8) :
+                encoding_(encoding), regex_scanner_(std::move(scanner)) {
+            any_char_ = {{' ', '}'}, {0x80, max_char()}};
         }
 
+        static const std::string kInitialMode; //!< Start condition of the rules without a <MODE> prefix.
+
+        /*!
+         * @brief Parses the specification and returns the rules active in #kInitialMode.
+         */
         std::vector <automata::NFA> Parse() {
-            Machine();
-            return lexical_nfa_;
+            return ParseModes().at(kInitialMode);
         }
+
+        /*!
+         * @brief Parses the specification into the simplified expression of every rule.
+         * @details The rules may be preceded by a definitions section closed by a %% line, with one
+         * "NAME regex" definition per line. A definition is parsed once and every {NAME} in the following
+         * definitions and rules shares its expression. Any other { that doesn't start a {m,n} repetition is a
+         * literal character. The specification is parsed only on the first call.
+         */
+        const std::vector<RegexRule> &ParseRules();
+
+        /*!
+         * @brief Parses the specification and groups the automata of its rules by start condition.
+         * @details A rule prefixed with <A,B> belongs to modes A and B, a rule prefixed with <*> to every mode,
+         * and a rule without prefix to #kInitialMode. Rules keep their order inside every mode. A < that doesn't
+         * open such a list is a literal character, so "<=   LE" matches <=, while a rule whose text looks like a
+         * prefix must quote it, as in "<a>"b.
+         * @return Every start condition of the specification with its rules.
+         */
+        std::map<std::string, std::vector <automata::NFA>> ParseModes();
     };
 } // namespace compiler::regex
 
@@ -6,7 +6,9 @@
 #ifndef SCANNER_H
 #define SCANNER_H
 
+#include <deque>
 #include <stack>
+#include <vector>
 #include "buffer.h"
 
 namespace compiler::regex {
@@ -31,6 +33,8 @@ namespace compiler::regex {
         PLUS_CLOSURE,     // +
         SEMICOLON,        // +
         COLON,            // +
+        OPEN_ANGLE,       // <
+        CLOSE_ANGLE,      // >
         TOKEN_ERROR       // Error
     };
 
@@ -50,7 +54,8 @@ namespace compiler::regex {
         bool in_quote_;
         bool escape_;
         RegexToken current_token_;
-        TokenCodeRegex char_code_map_[128]{};
+        std::deque<RegexToken> put_back_; //!< Tokens returned by GetNextToken() before reading the input again.
+        TokenCodeRegex char_code_map_[256]{};
 
     public:
         explicit RegexScanner(io_buffer::TextSourceBuffer *buffer);
@@ -61,6 +66,13 @@ namespace compiler::regex {
 
         virtual RegexToken GetNextToken();
 
+        /*!
+         * @brief Gives back tokens already read, so the parser can look ahead.
+         * @param tokens Tokens in the order they were read, ending with the current token. The first one becomes
+         * the current token and the next calls to GetNextToken() return the rest.
+         */
+        void PutBack(const std::vector<RegexToken> &tokens);
+
     };
 }// namespace compiler::regex
 #endif
@@ -0,0 +1,53 @@
+/*!
+ * @file utf8.h
+ * @brief Compilation of character classes into byte-level expressions.
+ * @details Lexer automata work on bytes, so a class of Unicode code points is compiled into the UTF-8 byte
+ * sequences that encode them, split in ranges that a concatenation of byte classes can recognize.
+ */
+
+#ifndef COMPILER_UTF8_H
+#define COMPILER_UTF8_H
+
+#include <utility>
+#include <vector>
+
+#include "parsers/regex_utils/regex_ast.h"
+
+namespace compiler::regex {
+
+    using CodePointRange = std::pair<char32_t, char32_t>; //!< Inclusive range of code points (or bytes).
+
+    const char32_t kMaxByte = 0xFF;          //!< Last symbol of a byte-level alphabet.
+    const char32_t kMaxCodePoint = 0x10FFFF; //!< Last Unicode code point.
+
+    /*!
+     * @brief Gets the length of the UTF-8 sequence started by @p lead, or 0 if @p lead can't start a sequence.
+     */
+    int Utf8SequenceLength(unsigned char lead);
+
+    /*!
+     * @brief Sorts and merges @p ranges, clipping them to [1, @p max_symbol].
+     * @details Symbol 0 is the epsilon label of automata::NFA, so it never belongs to a class. If @p max_symbol is
+     * kMaxCodePoint the UTF-16 surrogates, which have no UTF-8 encoding, are removed too.
+     */
+    std::vector<CodePointRange> NormalizeRanges(std::vector<CodePointRange> ranges, char32_t max_symbol);
+
+    /*!
+     * @brief Gets the symbols of [1, @p max_symbol] not covered by @p ranges.
+     */
+    std::vector<CodePointRange> ComplementRanges(const std::vector<CodePointRange> &ranges, char32_t max_symbol);
+
+    /*!
+     * @brief Creates an expression that matches one byte of @p ranges.
+     */
+    RegexNodePtr CreateByteClass(const std::vector<CodePointRange> &ranges);
+
+    /*!
+     * @brief Creates an expression that matches the UTF-8 encoding of one code point of @p ranges.
+     * @details Every range is split at the limits of the encoded lengths and of the continuation bytes, so every
+     * piece is a sequence of byte ranges, e.g. [U+0800, U+FFFF] becomes [E0][A0-BF][80-BF] | [E1-EF][80-BF][80-BF].
+     */
+    RegexNodePtr CreateUtf8Class(const std::vector<CodePointRange> &ranges);
+} //namespace compiler::regex
+
+#endif //COMPILER_UTF8_H
@@ -0,0 +1,35 @@
+#include "analyzers/compiled_lexer.h"
+
+namespace compiler::analyzers {
+
+    CompiledLexer::CompiledLexer(const automata::DFA &automata, std::shared_ptr<const KeywordTable> keywords) :
+            initial_state_(automata.initial_state()),
+            transitions_((automata.size() + 1) * kAlphabetSize, -1),
+            accepting_(automata.size() + 1, 0),
+            tokens_(automata.size() + 1),
+            keywords_(std::move(keywords)) {
+        for (const auto &transition : automata.transitions()) {
+            const auto &[state, c] = transition.first;
+            transitions_[state * kAlphabetSize + (unsigned char) c] = transition.second;
+        }
+        for (int state : automata.accepting_states())
+            accepting_[state] = 1;
+        for (const auto &token : automata.tokens())
+            tokens_[token.first] = token.second;
+    }
+
+    std::shared_ptr<const CompiledLexer> CompiledLexer::Compile(const std::vector<automata::NFA> &rules,
+                                                                std::shared_ptr<const KeywordTable> keywords) {
+        return std::make_shared<const CompiledLexer>(automata::NFA::CalculateLexicalUnion(rules).ToDFA().Minimize(),
+                                                     std::move(keywords));
+    }
+
+    std::shared_ptr<const LexerModes>
+    CompiledLexer::CompileModes(const std::map<std::string, std::vector<automata::NFA>> &mode_rules,
+                                const std::shared_ptr<const KeywordTable> &keywords) {
+        auto modes = std::make_shared<LexerModes>();
+        for (const auto &[mode, rules] : mode_rules)
+            (*modes)[mode] = Compile(rules, keywords);
+        return modes;
+    }
+} //namespace compiler::analyzers
@@ -0,0 +1,71 @@
+#include "analyzers/incremental_lexer.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace compiler::analyzers {
+
+    IncrementalLexer::IncrementalLexer(std::shared_ptr<const CompiledLexer> lexer, bool skip_whitespace) :
+            analyzer_(std::move(lexer), skip_whitespace) {
+        analyzer_.Reset(text_);
+    }
+
+    void IncrementalLexer::Reset(std::string text) {
+        text_ = std::move(text);
+        tokens_.clear();
+        analyzer_.Reset(text_);
+        Lex(0, tokens_);
+    }
+
+    void IncrementalLexer::Lex(std::size_t offset, std::vector<TokenSpan> &output) {
+        analyzer_.Seek(offset);
+        while (analyzer_.SkipWS(), !analyzer_.isInEnd()) {
+            std::size_t begin = analyzer_.offset();
+            Token token = analyzer_.yylex();
+            output.push_back({std::move(token), begin, analyzer_.offset()});
+        }
+    }
+
+    TokenEdit IncrementalLexer::Edit(std::size_t begin, std::size_t removed, std::string_view inserted) {
+        begin = std::min(begin, text_.size());
+        removed = std::min(removed, text_.size() - begin);
+        text_.replace(begin, removed, inserted);
+        analyzer_.Reset(text_);
+
+        // Tokens that stopped before the edit never read any of its characters.
+        auto first = std::partition_point(tokens_.begin(), tokens_.end(),
+                                          [begin](const TokenSpan &span) { return span.end < begin; });
+        std::size_t restart = first == tokens_.begin() ? 0 : std::prev(first)->end;
+        analyzer_.Seek(restart);
+
+        std::size_t new_edit_end = begin + inserted.size();
+        std::vector<TokenSpan> relexed;
+        auto old = first;
+        while (analyzer_.SkipWS(), !analyzer_.isInEnd()) {
+            std::size_t token_begin = analyzer_.offset();
+            Token token = analyzer_.yylex();
+            std::size_t token_end = analyzer_.offset();
+            relexed.push_back({std::move(token), token_begin, token_end});
+            if (token_end < new_edit_end)
+                continue;
+            std::size_t old_end = token_end - inserted.size() + removed;
+            while (old != tokens_.end() && old->end < old_end)
+                ++old;
+            if (old != tokens_.end() && old->end == old_end) {
+                ++old;
+                break;
+            }
+        }
+        if (analyzer_.isInEnd())
+            old = tokens_.end();
+
+        for (auto it = old; it != tokens_.end(); ++it) {
+            it->begin = it->begin + inserted.size() - removed;
+            it->end = it->end + inserted.size() - removed;
+        }
+        TokenEdit edit = {(std::size_t) (first - tokens_.begin()), (std::size_t) (old - first), relexed.size()};
+        first = tokens_.erase(first, old);
+        tokens_.insert(first, std::make_move_iterator(relexed.begin()), std::make_move_iterator(relexed.end()));
+        return edit;
+    }
+} //namespace compiler::analyzers
@@ -0,0 +1,119 @@
+#include "analyzers/keyword_table.h"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+#include "error.h"
+
+namespace compiler::analyzers {
+
+    namespace {
+        const std::uint32_t kMaxSeed = 1u << 16; //!< Seeds tried for a bucket before growing the table.
+    }
+
+    KeywordTable::KeywordTable(std::string identifier_token,
+                               const std::vector<std::pair<std::string, std::string>> &keywords) :
+            identifier_token_(std::move(identifier_token)) {
+        std::vector<std::pair<std::string, std::string>> unique_keywords;
+        std::set<std::string> saved;
+        for (const auto &keyword : keywords) {
+            if (saved.insert(keyword.first).second)
+                unique_keywords.push_back(keyword);
+        }
+        if (unique_keywords.empty())
+            return;
+
+        std::size_t step = unique_keywords.size() / 4 + 1;
+        std::size_t table_size = unique_keywords.size() + step;
+        while (!Build(unique_keywords, table_size))
+            table_size += step;
+    }
+
+    KeywordTable KeywordTable::Load(const std::string &fname, std::string identifier_token) {
+        std::ifstream file(fname);
+        if (!file.good())
+            AbortTranslation(error::SourceFileOpenFailed);
+        std::vector<std::pair<std::string, std::string>> keywords;
+        std::string keyword, token_name;
+        while (file >> keyword >> token_name)
+            keywords.emplace_back(keyword, token_name);
+        return KeywordTable(std::move(identifier_token), keywords);
+    }
+
+    std::uint32_t KeywordTable::Hash(std::string_view key, std::uint32_t seed) {
+        std::uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+        for (char c : key) {
+            hash ^= (unsigned char) c;
+            hash *= 16777619u;
+        }
+        hash ^= hash >> 16;
+        hash *= 0x85EBCA6Bu;
+        hash ^= hash >> 13;
+        hash *= 0xC2B2AE35u;
+        hash ^= hash >> 16;
+        return hash;
+    }
+
+    bool KeywordTable::Build(const std::vector<std::pair<std::string, std::string>> &keywords,
+                             std::size_t table_size) {
+        std::vector<std::vector<std::size_t>> buckets(keywords.size() / 2 + 1);
+        for (std::size_t i = 0; i < keywords.size(); ++i)
+            buckets[Hash(keywords[i].first, 0) % buckets.size()].push_back(i);
+
+        std::vector<std::size_t> order(buckets.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&buckets](std::size_t a, std::size_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        seeds_.assign(buckets.size(), 0);
+        slots_.assign(table_size, {});
+        std::vector<char> used(table_size, 0);
+        std::vector<std::size_t> bucket_slots;
+        for (std::size_t bucket : order) {
+            if (buckets[bucket].empty())
+                break;
+            std::uint32_t seed = 1;
+            for (; seed < kMaxSeed; ++seed) {
+                bucket_slots.clear();
+                for (std::size_t keyword : buckets[bucket]) {
+                    std::size_t slot = Hash(keywords[keyword].first, seed) % table_size;
+                    if (used[slot] || std::find(bucket_slots.begin(), bucket_slots.end(), slot) != bucket_slots.end())
+                        break;
+                    bucket_slots.push_back(slot);
+                }
+                if (bucket_slots.size() == buckets[bucket].size())
+                    break;
+            }
+            if (seed == kMaxSeed)
+                return false;
+
+            seeds_[bucket] = seed;
+            for (std::size_t i = 0; i < bucket_slots.size(); ++i) {
+                used[bucket_slots[i]] = 1;
+                const auto &keyword = keywords[buckets[bucket][i]];
+                slots_[bucket_slots[i]] = {keyword.first, keyword.second};
+            }
+        }
+        return true;
+    }
+
+    const std::string *KeywordTable::Find(std::string_view lexeme) const {
+        if (slots_.empty())
+            return nullptr;
+        std::uint32_t seed = seeds_[Hash(lexeme, 0) % seeds_.size()];
+        const Slot &slot = slots_[Hash(lexeme, seed) % slots_.size()];
+        if (slot.token_name.empty() || slot.keyword != lexeme)
+            return nullptr;
+        return &slot.token_name;
+    }
+
+    const std::string &KeywordTable::Classify(const std::string &token_name, std::string_view lexeme) const {
+        if (token_name != identifier_token_)
+            return token_name;
+        const std::string *keyword_token = Find(lexeme);
+        return keyword_token ? *keyword_token : token_name;
+    }
+} //namespace compiler::analyzers
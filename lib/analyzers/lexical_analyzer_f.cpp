@@ -4,29 +4,38 @@
 
 namespace compiler::analyzers {
 
-    LexicalAnalyzerF::LexicalAnalyzerF(io_buffer::TextSourceBuffer *inputFile, automata::DFA automata, bool skip_whitespace) :
-            LexicalAnalyzer(std::move(automata), skip_whitespace), input_file_(inputFile) {}
+    LexicalAnalyzerF::LexicalAnalyzerF(io_buffer::TextSourceBuffer *inputFile, const automata::DFA &automata, bool skip_whitespace) :
+            LexicalAnalyzer(automata, skip_whitespace), input_file_(inputFile) {}
+
+    LexicalAnalyzerF::LexicalAnalyzerF(io_buffer::TextSourceBuffer *inputFile, std::shared_ptr<const CompiledLexer> lexer,
+                                       bool skip_whitespace) :
+            LexicalAnalyzer(std::move(lexer), skip_whitespace), input_file_(inputFile) {}
+
+    void LexicalAnalyzerF::Reset(io_buffer::TextSourceBuffer *inputFile) {
+        input_file_ = inputFile;
+        current_token_ = {};
+    }
 
     Token LexicalAnalyzerF::yylex() {
         char c = SkipWS();
         if (isInEnd())
             return current_token_ = {"$", "$"};
 
-        if(automata_.Compute(automata_.initial_state(), c) == -1) {
+        if(lexer_->Compute(lexer_->initial_state(), c) == -1) {
             input_file_->FetchChar();
             return current_token_ = {"ANY", std::string(1, c)};
         }
 
-        int actual_state = automata_.initial_state();
+        int actual_state = lexer_->initial_state();
         std::string token_name;
         std::string lexeme;
         while (actual_state != -1) {
             if (isInEnd() || isEOS(c))
                 break;
             lexeme += c;
-            actual_state = automata_.Compute(actual_state, c);
-            if (automata_.accepting_states().count(actual_state))
-                token_name = automata_.tokens().at(actual_state);
+            actual_state = lexer_->Compute(actual_state, c);
+            if (actual_state != -1 && lexer_->isAccepting(actual_state))
+                token_name = lexer_->token(actual_state);
             c = input_file_->FetchChar();
         }
         if (isEOS(c) && actual_state != -1)
@@ -35,7 +44,7 @@ namespace compiler::analyzers {
             input_file_->PutBackChar();
             lexeme.pop_back();
         }
-        return current_token_ = {token_name, lexeme};
+        return current_token_ = {lexer_->Classify(token_name, lexeme), lexeme};
     }
 
     bool LexicalAnalyzerF::isInEnd() {
@@ -51,7 +60,7 @@ namespace compiler::analyzers {
     }
 
     bool LexicalAnalyzerF::isEOS(char c) {
-        return isspace(c) || c == '\0';
+        return isspace((unsigned char) c) || c == '\0';
     }
 } //namespace compiler::analyzers
 
@@ -0,0 +1,123 @@
+#include "analyzers/lexical_analyzer_p.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "buffer.h"
+#include "error.h"
+
+namespace compiler::analyzers {
+
+    LexicalAnalyzerP::LexicalAnalyzerP(const std::string &fname, const automata::DFA &automata, bool skip_whitespace,
+                                       unsigned threads) :
+            LexicalAnalyzerP(fname, std::make_shared<const CompiledLexer>(automata), skip_whitespace, threads) {}
+
+    LexicalAnalyzerP::LexicalAnalyzerP(const std::string &fname, std::shared_ptr<const CompiledLexer> lexer,
+                                       bool skip_whitespace, unsigned threads) :
+            LexicalAnalyzer(std::move(lexer), skip_whitespace) {
+        int fd = open(fname.c_str(), O_RDONLY);
+        if (fd == -1)
+            AbortTranslation(error::SourceFileOpenFailed);
+        struct stat file_stat{};
+        if (fstat(fd, &file_stat) == -1) {
+            close(fd);
+            AbortTranslation(error::SourceFileOpenFailed);
+        }
+        auto size = (size_t) file_stat.st_size;
+        if (size == 0) {
+            close(fd);
+            return;
+        }
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED)
+            AbortTranslation(error::SourceFileOpenFailed);
+        const char *text = static_cast<const char *>(mapping);
+
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        // Every chunk ends at a whitespace character, so the DFA is in its initial state at every boundary.
+        std::vector<const char *> limits = {text};
+        for (unsigned i = 1; i < threads; ++i) {
+            const char *limit = std::max(limits.back(), text + size * i / threads);
+            while (limit < text + size && !isspace((unsigned char) *limit))
+                ++limit;
+            if (limit < text + size && limit != limits.back())
+                limits.push_back(limit);
+        }
+        limits.push_back(text + size);
+
+        std::vector<std::vector<Token>> chunks(limits.size() - 1);
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < chunks.size(); ++i)
+            workers.emplace_back(&LexicalAnalyzerP::Tokenize, this, limits[i], limits[i + 1], std::ref(chunks[i]));
+        Tokenize(limits[0], limits[1], chunks[0]);
+        for (auto &worker : workers)
+            worker.join();
+        munmap(mapping, size);
+
+        std::size_t total = 0;
+        for (const auto &chunk : chunks)
+            total += chunk.size();
+        tokens_.reserve(total);
+        for (auto &chunk : chunks)
+            std::move(chunk.begin(), chunk.end(), std::back_inserter(tokens_));
+    }
+
+    void LexicalAnalyzerP::Tokenize(const char *begin, const char *end, std::vector<Token> &output) {
+        const char *c = begin;
+        while (c != end) {
+            if (isspace((unsigned char) *c) || *c == '\0') {
+                if (!skip_whitespace_)
+                    output.push_back({"ANY", std::string(1, *c)});
+                ++c;
+                continue;
+            }
+            if (lexer_->Compute(lexer_->initial_state(), *c) == -1) {
+                output.push_back({"ANY", std::string(1, *c++)});
+                continue;
+            }
+
+            int actual_state = lexer_->initial_state();
+            std::string token_name;
+            const char *lexeme_begin = c;
+            while (c != end && !isspace((unsigned char) *c) && *c != '\0') {
+                actual_state = lexer_->Compute(actual_state, *c);
+                if (actual_state == -1)
+                    break;
+                if (lexer_->isAccepting(actual_state))
+                    token_name = lexer_->token(actual_state);
+                ++c;
+            }
+            std::string lexeme(lexeme_begin, c);
+            output.push_back({lexer_->Classify(token_name, lexeme), std::move(lexeme)});
+        }
+    }
+
+    Token LexicalAnalyzerP::yylex() {
+        if (isInEnd())
+            return current_token_ = {"$", "$"};
+        return current_token_ = tokens_[position_++];
+    }
+
+    bool LexicalAnalyzerP::isInEnd() {
+        return position_ == tokens_.size();
+    }
+
+    char LexicalAnalyzerP::SkipWS() {
+        return isInEnd() ? io_buffer::EOF_char : tokens_[position_].lexeme.front();
+    }
+
+    void LexicalAnalyzerP::BeginMode(const std::string &mode) {
+        throw std::logic_error("LexicalAnalyzerP doesn't support start conditions, can't begin " + mode);
+    }
+} //namespace compiler::analyzers
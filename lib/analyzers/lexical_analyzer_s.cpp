@@ -1,13 +1,21 @@
 #include "analyzers/lexical_analyzer_s.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace compiler::analyzers {
 
-    LexicalAnalyzerS::LexicalAnalyzerS(std::string strInput, automata::DFA automata, bool skip_whitespace) :
-            LexicalAnalyzer(std::move(automata), skip_whitespace),
+    LexicalAnalyzerS::LexicalAnalyzerS(std::string strInput, const automata::DFA &automata, bool skip_whitespace) :
+            LexicalAnalyzer(automata, skip_whitespace),
             str_input_(std::move(strInput)) {
-        str_pos_ = str_input_.begin();
+        Reset(str_input_);
+    }
+
+    LexicalAnalyzerS::LexicalAnalyzerS(std::string strInput, std::shared_ptr<const CompiledLexer> lexer,
+                                       bool skip_whitespace) :
+            LexicalAnalyzer(std::move(lexer), skip_whitespace),
+            str_input_(std::move(strInput)) {
+        Reset(str_input_);
     }
 
     Token LexicalAnalyzerS::yylex() {
@@ -15,45 +23,55 @@ namespace compiler::analyzers {
         if (isInEnd())
             return current_token_ = {"$", "$"};
 
-        if(automata_.Compute(automata_.initial_state(), *str_pos_) == -1)
+        if(lexer_->Compute(lexer_->initial_state(), *str_pos_) == -1)
             return current_token_ = {"ANY", std::string(1, *str_pos_++)};
 
         std::string token_name;
         std::string lexeme;
 
-        int actual_state = automata_.initial_state();
+        int actual_state = lexer_->initial_state();
 
         while (actual_state != -1) {
+            SkipWS();
             if (isInEnd())
                 break;
-            SkipWS();
 
             lexeme += *str_pos_;
-            actual_state = automata_.Compute(actual_state, *str_pos_);
-            if (automata_.accepting_states().count(actual_state))
-                token_name = automata_.tokens().at(actual_state);
+            actual_state = lexer_->Compute(actual_state, *str_pos_);
+            if (actual_state != -1 && lexer_->isAccepting(actual_state))
+                token_name = lexer_->token(actual_state);
             str_pos_++;
         }
         if (actual_state == -1) {
             str_pos_--;
             lexeme.pop_back();
         }
-        return current_token_ = {token_name, lexeme};
+        return current_token_ = {lexer_->Classify(token_name, lexeme), lexeme};
     }
 
     bool LexicalAnalyzerS::isInEnd() {
-        return str_pos_ == str_input_.end();
+        return str_pos_ == input_.end();
     }
 
     void LexicalAnalyzerS::set_str_input(const std::string &new_str) {
-        str_input_ = new_str;
-        str_pos_ = str_input_.begin();
+        str_input_.assign(new_str);
+        Reset(str_input_);
+    }
+
+    void LexicalAnalyzerS::Reset(std::string_view input) {
+        input_ = input;
+        str_pos_ = input_.begin();
+        current_token_ = {};
+    }
+
+    void LexicalAnalyzerS::Seek(std::size_t offset) {
+        str_pos_ = input_.begin() + std::min(offset, input_.size());
     }
 
     char LexicalAnalyzerS::SkipWS() {
         if (skip_whitespace_) {
-            while (isspace(*str_pos_)) str_pos_++;
+            while (!isInEnd() && isspace((unsigned char) *str_pos_)) str_pos_++;
         }
-        return *str_pos_;
+        return isInEnd() ? '\0' : *str_pos_;
     }
-} //namespace compiler::analyzers
\ No newline at end of file
+} //namespace compiler::analyzers
@@ -118,24 +118,14 @@ namespace compiler::automata {
     DFA DFA::Minimize() {
         std::set <std::set<int>> P;
         std::map<int, std::string> new_tokens;
-        P.insert({*accepting_states_.begin()});
+        std::map<int, int> new_rules;
+        std::map<int, std::set<int>> rule_classes;
         for (int state : accepting_states_) {
-            if (tokens_[state] != tokens_[*accepting_states_.begin()]) {
-                auto it = P.begin();
-                while (it != P.end()) {
-                    if (tokens_[*((*it).begin())] == tokens_[state]) {
-                        std::set<int> a = *it;
-                        a.insert(state);
-                        P.insert(a);
-                        P.erase(*it);
-                        break;
-                    }
-                    it++;
-                }
-                if (it == P.end())
-                    P.insert({state});
-            }
+            auto rule = rules_.find(state);
+            rule_classes[rule != rules_.end() ? rule->second : -1].insert(state);
         }
+        for (const auto &rule_class : rule_classes)
+            P.insert(rule_class.second);
         std::set <std::set<int>> W;
         W.insert(P.begin(), P.end());
 
@@ -167,7 +157,7 @@ namespace compiler::automata {
                     P.insert(XY);
                     P.insert(Y_X);
                     if (W.count(Y) != 0) {
-                        W.erase(it);
+                        W.erase(Y);
                         W.insert(XY);
                         W.insert(Y_X);
                     } else {
@@ -218,6 +208,8 @@ namespace compiler::automata {
             for (const int state : accepting_states_) {
                 if (class_p.count(state) != 0) {
                     token = tokens_[state];
+                    if (rules_.count(state))
+                        new_rules.insert(std::make_pair(current_class, rules_[state]));
                     new_accepting.insert(current_class);
                 }
             }
@@ -225,7 +217,7 @@ namespace compiler::automata {
                 new_tokens.insert(make_pair(current_class, token));
             current_class++;
         }
-        return DFA(new_size, alphabet_, new_transitions, new_initial, new_accepting, new_tokens);
+        return DFA(new_size, alphabet_, new_transitions, new_initial, new_accepting, new_tokens, new_rules);
     }
 
     int DFA::Compute(const std::string &string_input) {
@@ -238,24 +230,37 @@ namespace compiler::automata {
         return current_state;
     }
 
-    int DFA::Compute(int state, char c) {
-        if(!transitions_.count(std::make_pair(state, c)))
+    int DFA::Compute(int state, char c) const {
+        auto transition = transitions_.find(std::make_pair(state, c));
+        if (transition == transitions_.end())
             return -1;
-        return transitions_[std::make_pair(state, c)];
+        return transition->second;
     }
 
-    int DFA::initial_state() {
+    int DFA::initial_state() const {
         return initial_state_;
     }
 
-    const std::set<int> &DFA::accepting_states() {
+    int DFA::size() const {
+        return size_;
+    }
+
+    const std::set<int> &DFA::accepting_states() const {
         return accepting_states_;
     }
 
-    const std::map<int, std::string> &DFA::tokens() {
+    const std::map<int, std::string> &DFA::tokens() const {
         return tokens_;
     }
 
+    const std::map<int, int> &DFA::rules() const {
+        return rules_;
+    }
+
+    const std::map<std::pair<int, char>, int> &DFA::transitions() const {
+        return transitions_;
+    }
+
     std::string DFA::ComputeString(const std::string &str) {
         int result = Compute(str);
         return tokens_.count(result) ? tokens_[result] : "";
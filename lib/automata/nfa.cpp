@@ -24,9 +24,23 @@ namespace compiler::automata {
         return alphabet;
     }
 
-    void NFA::AddAcceptingValue(const std::string &value) {
-        for (int accepting_state : accepting_states_)
+    void NFA::AddAcceptingValue(const std::string &value, int rule) {
+        for (int accepting_state : accepting_states_) {
             accepting_values_.insert(std::make_pair(accepting_state, value));
+            accepting_rules_.insert(std::make_pair(accepting_state, rule));
+        }
+    }
+
+    int NFA::SelectAcceptingState(const std::vector<int> &states) {
+        int selected = states.front(), selected_rule = -1;
+        for (int state : states) {
+            auto rule = accepting_rules_.find(state);
+            if (rule != accepting_rules_.end() && rule->second >= selected_rule) {
+                selected = state;
+                selected_rule = rule->second;
+            }
+        }
+        return selected;
     }
 
         std::string NFA::GetAcceptingValue(int state) {
@@ -40,6 +54,7 @@ namespace compiler::automata {
         std::set<char> new_alphabet = alphabet();
         std::set<int> new_final_states;
         std::map<int, std::string> new_tokens;
+        std::map<int, int> new_rules;
 
         // Preparing the algorithm
         std::vector <std::set<int>> old_states;
@@ -78,15 +93,16 @@ namespace compiler::automata {
                              back_inserter(intersection));
             if (!intersection.empty()) {
                 new_final_states.insert(dstate);
-                std::string token;
-                for (int state : intersection)
-                    token = accepting_values_[state];
+                int state = SelectAcceptingState(intersection);
+                if (accepting_rules_.count(state))
+                    new_rules.insert(std::make_pair(dstate, accepting_rules_[state]));
+                std::string token = accepting_values_[state];
                 if (!token.empty())
                     new_tokens.insert(std::make_pair(dstate, token));
             }
         }
 
-        return DFA(n, new_alphabet, new_transition, 1, new_final_states, new_tokens);
+        return DFA(n, new_alphabet, new_transition, 1, new_final_states, new_tokens, new_rules);
     }
 
     NFA::NFA(int size, int initial_state, const std::map <std::pair<int, char>, std::set<int>>& transitions,
@@ -202,7 +218,7 @@ namespace compiler::automata {
         std::set<int> t;
         t.insert(1);
 
-        for (char c = from; c <= to; c++)
+        for (int c = (unsigned char) from; c <= (unsigned char) to; c++)
             transitions.insert(std::pair < std::pair < int, char > , std::set < int >> (std::make_pair(0, c), t));
         accepting_states.insert(1);
 
@@ -290,6 +306,7 @@ namespace compiler::automata {
             result.transitions_.insert(nfa.transitions_.begin(), nfa.transitions_.end());
             start_states.insert(nfa.initial_state_);
             result.accepting_values_.insert(nfa.accepting_values_.begin(), nfa.accepting_values_.end());
+            result.accepting_rules_.insert(nfa.accepting_rules_.begin(), nfa.accepting_rules_.end());
         }
         result.states_.insert(result.initial_state_);
         result.AddTransition(result.initial_state_, start_states, '\0');
@@ -378,6 +395,36 @@ namespace compiler::automata {
         return result;
     }
 
+    NFA NFA::Clone() const {
+        NFA result;
+        std::map<int, int> renamed;
+        auto rename = [&renamed, &result](int state) {
+            auto it = renamed.find(state);
+            if (it == renamed.end()) {
+                it = renamed.insert(std::make_pair(state, NFA::state_counter())).first;
+                result.states_.insert(it->second);
+            }
+            return it->second;
+        };
+
+        for (int const state : this->states_)
+            rename(state);
+        result.initial_state_ = rename(this->initial_state_);
+        for (const auto &transition : this->transitions_) {
+            std::set<int> to;
+            for (int const state : transition.second)
+                to.insert(rename(state));
+            result.AddTransition(rename(transition.first.first), to, transition.first.second);
+        }
+        for (int const state : this->accepting_states_)
+            result.accepting_states_.insert(rename(state));
+        for (const auto &value : this->accepting_values_)
+            result.accepting_values_.insert(std::make_pair(rename(value.first), value.second));
+        for (const auto &rule : this->accepting_rules_)
+            result.accepting_rules_.insert(std::make_pair(rename(rule.first), rule.second));
+        return result;
+    }
+
     std::string NFA::LexicalAccept(char *str, std::string &token, std::string &lexeme, std::string &str_result) {
         std::set<int> configuration;
         configuration.insert(this->initial_state_);
@@ -398,8 +445,8 @@ namespace compiler::automata {
                 std::set_intersection(result.begin(), result.end(), accepting_states_.begin(),
                                  accepting_states_.end(), inserter(intersection, intersection.begin()));
                 if (!intersection.empty()) {
-                    for (int last_state : intersection)
-                        token = accepting_values_[last_state];
+                    token = accepting_values_[SelectAcceptingState(
+                            std::vector<int>(intersection.begin(), intersection.end()))];
                     for (int i = 0; i <= input_pos; i++, str++);
                     lexeme = std::string(text);
                     str_result = std::string(str);
@@ -43,6 +43,16 @@ namespace compiler::io_buffer {
         GetLine();
     }
 
+    void TextSourceBuffer::Reopen(const std::string &fname) {
+        file_.close();
+        file_.clear();
+        file_name_ = fname;
+        file_.open(file_name_, std::fstream::in);
+        if (!file_.good()) AbortTranslation(error::SourceFileOpenFailed);
+        if (list_flag) list.Init(fname);
+        GetLine();
+    }
+
     char TextSourceBuffer::GetLine() {
         if (file_.eof()) current_char_ = &EOF_char;
         else {
@@ -0,0 +1,58 @@
+#include "parsers/grammar_utils/frozen_grammar.h"
+
+#include "parsers/grammar_utils/grammar_array.h"
+
+namespace compiler::grammar {
+
+    FrozenGrammar::FrozenGrammar(const GrammarArray &grammar) {
+        auto add_symbol = [this](const std::string &name) {
+            if (ids_.emplace(name, (Symbol) names_.size()).second)
+                names_.push_back(name);
+        };
+        for (const auto &terminal : grammar.terminals())
+            add_symbol(terminal);
+        add_symbol("$");
+        for (int i = 0; i < grammar.size(); ++i) {
+            for (const auto &symbol : grammar.GetRuleFromIndex(i).second) {
+                if (symbol != "#" && !grammar.non_terminals().count(symbol))
+                    add_symbol(symbol);
+            }
+        }
+        terminal_count_ = (int) names_.size();
+        for (const auto &variable : grammar.non_terminals())
+            add_symbol(variable);
+        axiom_ = Id(grammar.axiom());
+        end_ = Id("$");
+
+        right_offsets_.push_back(0);
+        std::vector<int> rule_counts(variable_count(), 0);
+        for (int i = 0; i < grammar.size(); ++i) {
+            const auto &[variable, rule] = grammar.GetRuleFromIndex(i);
+            left_.push_back(ids_.at(variable));
+            for (const auto &symbol : rule) {
+                if (symbol != "#")
+                    right_.push_back(ids_.at(symbol));
+            }
+            right_offsets_.push_back((int) right_.size());
+            ++rule_counts[VariableIndex(left_.back())];
+        }
+
+        rule_offsets_.assign(variable_count() + 1, 0);
+        for (int i = 0; i < variable_count(); ++i)
+            rule_offsets_[i + 1] = rule_offsets_[i] + rule_counts[i];
+        rules_.resize(left_.size());
+        std::vector<int> next(rule_offsets_.begin(), rule_offsets_.end() - 1);
+        for (int i = 0; i < rule_count(); ++i)
+            rules_[next[VariableIndex(left_[i])]++] = i;
+
+        for (int i = 0; i < terminal_count_; ++i)
+            precedences_.push_back(grammar.GetPrecedence(names_[i]));
+        for (int i = 0; i < rule_count(); ++i)
+            rule_precedences_.push_back(grammar.GetRulePrecedence(i));
+    }
+
+    FrozenGrammar::Symbol FrozenGrammar::Id(const std::string &name) const {
+        auto id = ids_.find(name);
+        return id == ids_.end() ? -1 : id->second;
+    }
+} // namespace compiler::grammar
@@ -6,7 +6,12 @@
 namespace compiler::grammar {
 
     GrammarAnalyzer::GrammarAnalyzer(io_buffer::TextSourceBuffer *input_file) :
-            LexicalAnalyzerF(input_file, CreateAutomaton()) {}
+            LexicalAnalyzerF(input_file, CreateLexer()) {}
+
+    std::shared_ptr<const analyzers::CompiledLexer> GrammarAnalyzer::CreateLexer() {
+        static const auto lexer = std::make_shared<const analyzers::CompiledLexer>(CreateAutomaton());
+        return lexer;
+    }
 
     automata::DFA GrammarAnalyzer::CreateAutomaton() {
         regex::RegexScanner scanner(CreateFileBuffer());
@@ -24,6 +29,10 @@ namespace compiler::grammar {
         file_out << R"(";"                           SEMICOLON)" << std::endl;
         file_out << R"("#"                           EPSILON)" << std::endl;
         file_out << R"("|"                           OR)" << std::endl;
+        file_out << R"("%left"                       LEFT)" << std::endl;
+        file_out << R"("%right"                      RIGHT)" << std::endl;
+        file_out << R"("%nonassoc"                   NONASSOC)" << std::endl;
+        file_out << R"("%prec"                       PREC)" << std::endl;
         file_out << R"("'"                          APOS)" << std::endl;
         file_out << R"("""                          QM)" << std::endl;
         static io_buffer::TextSourceBuffer regex_grammar_file(regex_file);
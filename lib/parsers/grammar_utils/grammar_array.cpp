@@ -1,7 +1,5 @@
 #include "parsers/grammar_utils/grammar_array.h"
 
-#include <algorithm>
-
 namespace compiler::grammar {
 
     std::ostream &operator<<(std::ostream &ostream, const GrammarArray &obj) {
@@ -30,19 +28,18 @@ namespace compiler::grammar {
         return ostream;
     }
 
-    std::set<std::vector<std::string>> GrammarArray::operator[](const std::string &index){
+    const std::set<std::vector<std::string>> &GrammarArray::operator[](const std::string &index) const {
         return rules_array_.at(index);
     }
 
 //insercion a la coleccion de reglas.
     void GrammarArray::InsertRule(const std::string &variable, const std::vector<std::string> &rule) {
-        non_terminals_.insert(variable);
-        if (rules_array_.count(variable))
-            rules_array_[variable].insert(rule);
-        else
-            rules_array_.insert({variable, {rule}});
-
-        UpdateTerminals();
+        if (non_terminals_.insert(variable).second)
+            terminals_.erase(variable);
+        if (!rules_array_[variable].insert(rule).second)
+            return;
+        AddTerminals(rule);
+        Invalidate();
 
         if (axiom_.empty())
             axiom_ = variable;
@@ -50,132 +47,231 @@ namespace compiler::grammar {
         index_rule_.insert({variable, rule}, index_rule_.size());
     }
 
-    void GrammarArray::UpdateTerminals() {
-        terminals_.clear();
-        for (const auto &rules : rules_array_) {
-            for (const auto &rule : rules.second) {
-                std::set<std::string> saver(rule.begin(), rule.end());
-                std::set_difference(saver.begin(), saver.end(), non_terminals_.begin(), non_terminals_.end(),
-                                    std::inserter(terminals_, terminals_.end()));
-            }
+    void GrammarArray::AddTerminals(const std::vector<std::string> &rule) {
+        for (const auto &symbol : rule) {
+            if (symbol != "#" && !non_terminals_.count(symbol))
+                terminals_.insert(symbol);
         }
-        terminals_.erase("#");
     }
 
     void GrammarArray::InsertTerminal(const std::string &new_symbol){
         terminals_.insert(new_symbol);
+        Invalidate();
     }
 
-    std::set<std::pair<std::string, std::vector<std::string>>>
-    GrammarArray::GetRightSides(const std::string &variable) {
-        std::set<std::pair<std::string, std::vector<std::string>>> left_vars;
-        for (const auto &rules : rules_array_) {
-            for (const auto &rule : rules.second) {
-                if (std::find(rule.begin(), rule.end(), variable) != rule.end())
-                    left_vars.insert({rules.first, rule});
-            }
-        }
-        return left_vars;
-    }
-
-    std::set<std::vector<std::string>> GrammarArray::GetVariableRules(const std::string &variable) {
+    const std::set<std::vector<std::string>> &GrammarArray::GetVariableRules(const std::string &variable) const {
         return rules_array_.at(variable);
     }
 
-    bool GrammarArray::canGenerateEpsilon(const std::string &variable, std::set<std::string> &calculated) {
-        if(calculated.count(variable))
-            return false;
-        calculated.insert(variable);
-        if (non_terminals_.count(variable)) {
-            for (const auto &rule : GetVariableRules(variable)) {
-                if (rule.front() == "#" || canGenerateEpsilon(rule.front(), calculated))
-                    return true;
-            }
-            return false;
+    const FrozenGrammar &GrammarArray::Freeze() {
+        if (!frozen_) {
+            frozen_grammar_ = FrozenGrammar(*this);
+            frozen_ = true;
         }
-        return false;
+        return frozen_grammar_;
     }
 
-    bool GrammarArray::canGenerateEpsilon(const std::string &variable) {
-        std::set<std::string> empty_set;
-        return canGenerateEpsilon(variable, empty_set);
+    void GrammarArray::Invalidate() {
+        frozen_ = false;
+        analyzed_ = false;
     }
 
-    std::set<std::string> GrammarArray::First(const std::vector<std::string> &expression_vector) {
-        std::set<std::string> calculated = {};
-        std::string front_elem = expression_vector.front();
-        if (terminals_.count(front_elem) || front_elem == "#")
-            return {front_elem};
-        std::set<std::string> first_result;
-        for (const auto &str : expression_vector) {
-            auto first_saver = First(str, calculated);
-            first_result.insert(first_saver.begin(), first_saver.end());
-            if (!first_saver.count("#")) {
-                first_result.erase("#");
-                break;
+    void GrammarArray::Analyze() {
+        if (analyzed_)
+            return;
+        const FrozenGrammar &grammar = Freeze();
+        analyzed_ = true;
+        first_sets_.clear();
+        follow_sets_.clear();
+
+        std::size_t variables = grammar.variable_count();
+        std::vector<std::vector<int>> users(variables);
+        for (int i = 0; i < grammar.rule_count(); ++i) {
+            for (auto symbol : grammar.Right(i)) {
+                if (grammar.IsTerminal(symbol))
+                    continue;
+                auto &rules = users[grammar.VariableIndex(symbol)];
+                if (rules.empty() || rules.back() != i)
+                    rules.push_back(i);
             }
         }
-        return first_result;
-    }
-
-    std::set<std::string> GrammarArray::First(const std::string &expression, std::set<std::string> &calculated) {
-        if(calculated.count(expression))
-            return {};
-        if (terminals_.count(expression) || expression == "#")
-            return {expression};
-        calculated.insert(expression);
-        std::set<std::string> first_result;
-        std::set<std::vector<std::string>> rules = GetVariableRules(expression);
-        if (canGenerateEpsilon(expression)) {
-            first_result.insert("#");
-            rules.erase({"#"});
+
+        std::vector<int> worklist;
+        std::vector<char> queued;
+        auto reset = [&]() {
+            worklist.resize(grammar.rule_count());
+            for (int i = 0; i < grammar.rule_count(); ++i)
+                worklist[i] = grammar.rule_count() - 1 - i;
+            queued.assign(grammar.rule_count(), 1);
+        };
+        auto push = [&](const int *first, const int *last) {
+            for (; first != last; ++first) {
+                if (!queued[*first]) {
+                    queued[*first] = 1;
+                    worklist.push_back(*first);
+                }
+            }
+        };
+        auto pop = [&]() {
+            int rule = worklist.back();
+            worklist.pop_back();
+            queued[rule] = 0;
+            return rule;
+        };
+
+        nullable_.assign(variables, 0);
+        reset();
+        while (!worklist.empty()) {
+            int i = pop();
+            int variable = grammar.VariableIndex(grammar.Left(i));
+            if (nullable_[variable])
+                continue;
+            bool nullable = true;
+            for (auto symbol : grammar.Right(i))
+                nullable = nullable && !grammar.IsTerminal(symbol) && nullable_[grammar.VariableIndex(symbol)];
+            if (nullable) {
+                nullable_[variable] = 1;
+                push(users[variable].data(), users[variable].data() + users[variable].size());
+            }
         }
-        for (const auto &rule : rules) {
-            int i = 0;
-            for (const auto &var : rule) {
-                std::set<std::string> aux = First(var, calculated);
-                first_result.insert(aux.begin(), aux.end());
-                if (!canGenerateEpsilon(var))
+
+        first_.assign(variables, TerminalSet(grammar.terminal_count()));
+        reset();
+        while (!worklist.empty()) {
+            int i = pop();
+            int variable = grammar.VariableIndex(grammar.Left(i));
+            bool changed = false;
+            for (auto symbol : grammar.Right(i)) {
+                if (grammar.IsTerminal(symbol)) {
+                    changed = changed || !first_[variable].Contains(symbol);
+                    first_[variable].Insert(symbol);
+                    break;
+                }
+                changed = first_[variable].Merge(first_[grammar.VariableIndex(symbol)]) || changed;
+                if (!nullable_[grammar.VariableIndex(symbol)])
                     break;
-                i++;
             }
-            if (i == rule.size())
-                first_result.insert("#");
+            if (changed)
+                push(users[variable].data(), users[variable].data() + users[variable].size());
         }
-        return first_result;
-    }
-
-    std::set<std::string> GrammarArray::Follow(const std::string &variable, std::set<std::string> &calculated) {
-        if (calculated.count(variable))
-            return {};
-        std::set<std::string> follow_result;
-        calculated.insert(variable);
-        if (variable == axiom_)
-            follow_result.insert("$");
-
-        for (const auto &rule : GetRightSides(variable)) {
-            if (rule.second.back() != variable) {
-                std::vector<std::string> rule_saver = rule.second;
-                auto next_expr = ++std::find(rule_saver.begin(), rule_saver.end(), variable);
-                rule_saver.erase(rule_saver.begin(), next_expr);
-                std::set<std::string> first_saver = First(rule_saver);
-                follow_result.insert(first_saver.begin(), first_saver.end());
-                if (first_saver.count("#")) {
-                    follow_result.erase("#");
-                    std::set<std::string> rec_follow = Follow(rule.first, calculated);
-                    follow_result.insert(rec_follow.begin(), rec_follow.end());
+
+        follow_.assign(variables, TerminalSet(grammar.terminal_count()));
+        if (grammar.axiom() >= 0)
+            follow_[grammar.VariableIndex(grammar.axiom())].Insert(grammar.end());
+        reset();
+        TerminalSet trailer(grammar.terminal_count());
+        while (!worklist.empty()) {
+            int i = pop();
+            auto right = grammar.Right(i);
+            // Every symbol is followed by the first of the symbols after it, and by the follow of the variable
+            // if all of them can generate epsilon.
+            trailer = follow_[grammar.VariableIndex(grammar.Left(i))];
+            for (auto symbol = right.end(); symbol != right.begin();) {
+                --symbol;
+                if (grammar.IsTerminal(*symbol)) {
+                    trailer.Clear();
+                    trailer.Insert(*symbol);
+                    continue;
                 }
-            } else {
-                std::set<std::string> rec_follow = Follow(rule.first, calculated);
-                follow_result.insert(rec_follow.begin(), rec_follow.end());
+                int variable = grammar.VariableIndex(*symbol);
+                if (follow_[variable].Merge(trailer))
+                    push(grammar.Rules(*symbol).begin(), grammar.Rules(*symbol).end());
+                if (nullable_[variable])
+                    trailer.Merge(first_[variable]);
+                else
+                    trailer = first_[variable];
             }
         }
-        return follow_result;
+
+        auto to_set = [&grammar](const TerminalSet &bits) {
+            std::set<std::string> result;
+            bits.ForEach([&](int terminal) { result.insert(grammar.Name(terminal)); });
+            return result;
+        };
+        follow_sets_.resize(variables);
+        for (std::size_t i = 0; i < variables; ++i) {
+            const auto &variable = grammar.Name(grammar.terminal_count() + (int) i);
+            first_sets_[variable] = to_set(first_[i]);
+            if (nullable_[i])
+                first_sets_[variable].insert("#");
+            follow_sets_[i] = to_set(follow_[i]);
+        }
+    }
+
+    bool GrammarArray::Nullable(const std::string &symbol) {
+        Analyze();
+        auto id = frozen_grammar_.Id(symbol);
+        return symbol == "#" || (id >= 0 && !frozen_grammar_.IsTerminal(id) &&
+                                 nullable_[frozen_grammar_.VariableIndex(id)]);
+    }
+
+    bool GrammarArray::Nullable(FrozenGrammar::Symbol variable) {
+        Analyze();
+        return nullable_[frozen_grammar_.VariableIndex(variable)];
     }
 
-    std::set<std::string> GrammarArray::Follow(const std::string &variable) {
-        std::set<std::string> empty_set;
-        return Follow(variable, empty_set);
+    const TerminalSet &GrammarArray::FirstSet(FrozenGrammar::Symbol variable) {
+        Analyze();
+        return first_[frozen_grammar_.VariableIndex(variable)];
+    }
+
+    const TerminalSet &GrammarArray::FollowSet(FrozenGrammar::Symbol variable) {
+        Analyze();
+        return follow_[frozen_grammar_.VariableIndex(variable)];
+    }
+
+    std::set<std::string> GrammarArray::First(const std::vector<std::string> &expression_vector) {
+        return First(expression_vector, 0, "#");
+    }
+
+    std::set<std::string> GrammarArray::First(const std::vector<std::string> &expression_vector, std::size_t from,
+                                              const std::string &lookahead) {
+        Analyze();
+        const FrozenGrammar &grammar = frozen_grammar_;
+        TerminalSet bits(grammar.terminal_count());
+        std::set<std::string> result;
+        auto add = [&](const std::string &name) {
+            if (name == "#")
+                return true;
+            auto symbol = grammar.Id(name);
+            if (symbol < 0) {
+                result.insert(name);
+                return false;
+            }
+            if (grammar.IsTerminal(symbol)) {
+                bits.Insert(symbol);
+                return false;
+            }
+            bits.Merge(first_[grammar.VariableIndex(symbol)]);
+            return (bool) nullable_[grammar.VariableIndex(symbol)];
+        };
+
+        bool nullable = true;
+        for (std::size_t i = from; nullable && i < expression_vector.size(); ++i)
+            nullable = add(expression_vector[i]);
+        if (nullable)
+            nullable = add(lookahead);
+        bits.ForEach([&](int terminal) { result.insert(grammar.Name(terminal)); });
+        if (nullable)
+            result.insert("#");
+        return result;
+    }
+
+    const std::set<std::string> &GrammarArray::First(const std::string &expression) {
+        Analyze();
+        auto first = first_sets_.find(expression);
+        if (first == first_sets_.end())
+            first = first_sets_.emplace(expression, std::set<std::string>{expression}).first;
+        return first->second;
+    }
+
+    const std::set<std::string> &GrammarArray::Follow(const std::string &variable) {
+        static const std::set<std::string> kEmpty;
+        Analyze();
+        auto id = frozen_grammar_.Id(variable);
+        if (id < 0 || frozen_grammar_.IsTerminal(id))
+            return kEmpty;
+        return follow_sets_[frozen_grammar_.VariableIndex(id)];
     }
 
     const std::string &GrammarArray::axiom() const {
@@ -202,6 +298,34 @@ namespace compiler::grammar {
         return index_rule_[index];
     }
 
+    void GrammarArray::SetPrecedence(const std::string &terminal, Precedence precedence) {
+        precedences_[terminal] = precedence;
+        Invalidate();
+    }
+
+    void GrammarArray::SetRulePrecedence(const std::string &variable, const std::vector<std::string> &rule,
+                                         const std::string &terminal) {
+        rule_precedences_[GetRuleIndex(variable, rule)] = terminal;
+        Invalidate();
+    }
+
+    Precedence GrammarArray::GetPrecedence(const std::string &terminal) const {
+        auto precedence = precedences_.find(terminal);
+        return precedence == precedences_.end() ? Precedence() : precedence->second;
+    }
+
+    Precedence GrammarArray::GetRulePrecedence(int index) const {
+        auto terminal = rule_precedences_.find(index);
+        if (terminal != rule_precedences_.end())
+            return GetPrecedence(terminal->second);
+        const auto &rule = index_rule_[index].second;
+        for (auto symbol = rule.rbegin(); symbol != rule.rend(); ++symbol) {
+            if (terminals_.count(*symbol))
+                return GetPrecedence(*symbol);
+        }
+        return {};
+    }
+
     void GrammarArray::ToAugmentedGrammar(std::string new_axiom) {
         if (new_axiom.empty())
             new_axiom = axiom_ + "_p";
@@ -210,7 +334,7 @@ namespace compiler::grammar {
             new_axiom += "_";
         terminals_.insert("$");
         InsertRule(new_axiom, {axiom_});
-        axiom_ = new_axiom;
+        set_axiom(new_axiom);
     }
 
     GrammarArray GrammarArray::GetAugmentedGrammar(std::string new_axiom) {
@@ -222,13 +346,14 @@ namespace compiler::grammar {
             new_axiom += "_";
         new_grammar.InsertRule(new_axiom, {axiom_});
         new_grammar.set_axiom(new_axiom);
-        new_grammar.terminals_.insert("$");
+        new_grammar.InsertTerminal("$");
 
         return new_grammar;
     }
 
     void GrammarArray::set_axiom(const std::string &new_axiom) {
         GrammarArray::axiom_ = new_axiom;
+        Invalidate();
     }
 
     GrammarArray::GrammarArray() = default;
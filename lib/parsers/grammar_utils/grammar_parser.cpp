@@ -3,29 +3,58 @@
 namespace compiler::grammar {
 
     void GrammarParser::Grammar(GrammarArray &new_grammar) {
-        while (scanner_.current_token() != "$") {
-            Rule(new_grammar);
+        while (scanner_.yylex() != "$") {
+            if (scanner_.current_token() == "LEFT" || scanner_.current_token() == "RIGHT" ||
+                scanner_.current_token() == "NONASSOC")
+                Declaration(new_grammar);
+            else
+                Rule(new_grammar);
+        }
+    }
+
+    void GrammarParser::Declaration(GrammarArray &new_grammar) {
+        Precedence precedence;
+        precedence.level = ++precedence_level_;
+        if (scanner_.current_token() == "RIGHT")
+            precedence.associativity = Precedence::Associativity::kRight;
+        else if (scanner_.current_token() == "NONASSOC")
+            precedence.associativity = Precedence::Associativity::kNonAssoc;
+
+        if (scanner_.yylex() == "SEMICOLON")
+            SyntaxError(error::MissingPrecedenceSymbol);
+        while (scanner_.current_token() != "SEMICOLON") {
+            if (scanner_.current_token() == "$" || scanner_.current_token() == "COLON")
+                SyntaxError(error::MissingSemicolon);
+            new_grammar.SetPrecedence(Symbol(), precedence);
+            scanner_.yylex();
         }
     }
 
     void GrammarParser::Rule(GrammarArray &new_grammar) {
         std::string left_s;
-        if (scanner_.yylex() == "VAR") {
+        if (scanner_.current_token() == "VAR") {
             left_s = scanner_.current_token().lexeme;
             if (scanner_.yylex() == "COLON") {
                 while (scanner_.current_token() != "SEMICOLON")
                     RightSide(left_s, new_grammar);
             } else SyntaxError(error::MissingColon);
-        } else if (scanner_.current_token() == "$");
-        else SyntaxError(error::MissingRuleName);
+        } else SyntaxError(error::MissingRuleName);
     }
 
     void GrammarParser::RightSide(const std::string &left_s, GrammarArray &new_grammar) {
         std::vector<std::string> right_s;
+        std::string precedence;
         analyzers::Token saver = scanner_.current_token();
         while (scanner_.yylex() != "OR" && scanner_.current_token() != "SEMICOLON") {
             if (scanner_.current_token() == "$" || scanner_.current_token() == "COLON")
                 SyntaxError(error::MissingSemicolon);
+            if (scanner_.current_token() == "PREC") {
+                if (scanner_.yylex() == "OR" || scanner_.current_token() == "SEMICOLON" ||
+                    scanner_.current_token() == "$")
+                    SyntaxError(error::MissingPrecedenceSymbol);
+                precedence = Symbol();
+                continue;
+            }
             right_s.push_back(Symbol());
             saver = scanner_.current_token();
         }
@@ -37,6 +66,8 @@ namespace compiler::grammar {
         else if (saver == "OR" && scanner_.current_token() == "SEMICOLON")
             right_s.emplace_back("#");
         new_grammar.InsertRule(left_s, right_s);
+        if (!precedence.empty())
+            new_grammar.SetRulePrecedence(left_s, right_s, precedence);
     }
 
     std::string GrammarParser::Symbol() {
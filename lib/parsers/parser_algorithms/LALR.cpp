@@ -1,210 +1,189 @@
-#include <stack>
 #include <algorithm>
-#include <parsers/parser_algorithms/LR1.h>
 #include "parsers/parser_algorithms/LALR.h"
 
 namespace compiler::parsers {
 
-    LALR::ItemSet LALR::ItemsClosure(const Item &item_input, ItemSet &calculated) {
-        if (calculated.count(item_input))
-            return {};
-        calculated.insert(item_input);
-        ItemSet closure_result = {item_input};
-        if (item_input.lr0_item.point < item_input.lr0_item.rule.size() &&
-            grammar_.non_terminals().count(item_input.lr0_item.PointSymbol())) {
-            auto rules = grammar_[item_input.lr0_item.PointSymbol()];
-            for (const auto &rule : rules) {
-
-                std::vector<std::string> saver;
-                saver.insert(saver.end(), item_input.lr0_item.rule.begin() + item_input.lr0_item.point + 1,
-                             item_input.lr0_item.rule.end());
-                saver.push_back(item_input.token);
-
-                for (const auto &token : grammar_.First(saver)) {
-                    Item item_saver = {{item_input.lr0_item.PointSymbol(), rule, 0}, token};
-                    auto closure_saver = ItemsClosure(item_saver, calculated);
-                    if (!closure_saver.empty())
-                        closure_result.insert(closure_saver.begin(), closure_saver.end());
+    namespace {
+        /*!
+         * @brief Digraph algorithm: makes @p sets[x] the union of the sets of every y reachable from x in
+         * @p relation, merging strongly connected components in one traversal.
+         */
+        void Digraph(const std::vector<std::vector<int>> &relation, std::vector<grammar::TerminalSet> &sets) {
+            struct Frame {
+                int node;
+                std::size_t edge; //!< Next edge of #node to follow.
+                int depth;        //!< Size of the stack when #node was pushed.
+            };
+            const int infinity = (int) sets.size() + 1;
+            std::vector<int> depth(sets.size(), 0), stack;
+            std::vector<Frame> frames;
+            auto visit = [&](int node) {
+                stack.push_back(node);
+                depth[node] = (int) stack.size();
+                frames.push_back({node, 0, depth[node]});
+            };
+            for (int root = 0; root < (int) sets.size(); ++root) {
+                if (depth[root])
+                    continue;
+                visit(root);
+                while (!frames.empty()) {
+                    Frame &frame = frames.back();
+                    int x = frame.node;
+                    if (frame.edge < relation[x].size()) {
+                        int y = relation[x][frame.edge++];
+                        if (!depth[y]) {
+                            visit(y);
+                        } else {
+                            depth[x] = std::min(depth[x], depth[y]);
+                            sets[x].Merge(sets[y]);
+                        }
+                        continue;
+                    }
+                    // x is the root of a strongly connected component, every node in it gets the same set.
+                    if (depth[x] == frame.depth) {
+                        while (true) {
+                            int top = stack.back();
+                            stack.pop_back();
+                            depth[top] = infinity;
+                            if (top == x)
+                                break;
+                            sets[top] = sets[x];
+                        }
+                    }
+                    frames.pop_back();
+                    if (!frames.empty()) {
+                        int parent = frames.back().node;
+                        depth[parent] = std::min(depth[parent], depth[x]);
+                        sets[parent].Merge(sets[x]);
+                    }
                 }
             }
         }
-        return closure_result;
-    }
-
-    LALR::ItemSet LALR::ItemsClosure(const ItemSet &input_items) {
-        ItemSet closure_result = {}, calculated = {};
-        for (const auto &item : input_items) {
-            auto closure_saver = ItemsClosure(item, calculated);
-            if (!closure_saver.empty())
-                closure_result.insert(closure_saver.begin(), closure_saver.end());
-        }
-        return closure_result;
     }
 
-    LALR::ItemSet LALR::goTo(const ItemSet &input_items, const std::string &input_symbol) {
-        if (input_symbol == "$")
-            return {};
-        ItemSet goto_result = {};
-        for (const Item &item : input_items) {
-            if (item.lr0_item.point < item.lr0_item.rule.size() && item.lr0_item.PointSymbol() == input_symbol)
-                goto_result.insert({{item.lr0_item.variable, item.lr0_item.rule, item.lr0_item.point + 1}, item.token});
-        }
-        goto_result = ItemsClosure(goto_result);
-        return goto_result;
-    }
-
-    std::set<LALR::ItemSet> LALR::GenerateStates() {
+    LALR::LALR(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar,
+               unsigned threads) :
+            LRParser(tokenizer,
+                   augment_grammar ? parser.ParseGrammar().GetAugmentedGrammar() : parser.ParseGrammar()) {
         grammar_.InsertTerminal("$");
+        const auto &axiom_rule = *grammar_[grammar_.axiom()].begin();
+        int axiom_index = grammar_.GetRuleIndex(grammar_.axiom(), axiom_rule);
+        LR0Automaton automaton(grammar_.Freeze(), axiom_index, threads);
+        CreateParsingTable(automaton, ComputeLookaheads(automaton, axiom_index), PackItem(axiom_index, 1));
+    }
 
-        std::string ax_saver = grammar_.axiom();
-        auto rule_saver = *grammar_[ax_saver].begin();
-
-        Item axiom = {{ax_saver, rule_saver, 0}, "$"};
-
-        auto first_state = ItemsClosure({axiom});
-        std::stack<ItemSet> lr1_states;
-        lr1_states.push(first_state);
-        std::set<ItemSet> states_set = {first_state};
-
-        while (!lr1_states.empty()) {
-            ItemSet actual_state = lr1_states.top();
-            lr1_states.pop();
-
-            std::set<std::string> symbol_set;
-            for (const auto &item : actual_state) {
-                if (item.lr0_item.point < item.lr0_item.rule.size())
-                    symbol_set.insert(item.lr0_item.PointSymbol());
-            }
-
-            for (const auto &symbol : symbol_set) {
-                ItemSet new_state = ItemsClosure(goTo(actual_state, symbol));
-                if (!new_state.empty()) {
-                    if (!states_set.count(new_state)) {
-                        lr1_states.push(new_state);
-                        states_set.insert(new_state);
-                    }
+    LALR::Reductions LALR::ComputeLookaheads(const LR0Automaton &automaton, int start_rule) {
+        const auto &grammar = automaton.grammar();
+        grammar::TerminalSet empty(grammar.terminal_count());
+
+        // Transitions on variables, the last one is a virtual transition on the axiom from state 0 followed by "$".
+        std::vector<std::pair<int, LR0Automaton::Symbol>> transitions;
+        std::map<std::pair<int, LR0Automaton::Symbol>, int> transition_ids;
+        for (int state = 0; state < automaton.size(); ++state) {
+            for (const auto &[symbol, next_state] : automaton[state].transitions) {
+                if (!grammar.IsTerminal(symbol)) {
+                    transition_ids[{state, symbol}] = (int) transitions.size();
+                    transitions.emplace_back(state, symbol);
                 }
             }
         }
-        return states_set;
-    }
-
-    LALR::LALR(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar) :
-            Parser(tokenizer,
-                   augment_grammar ? parser.ParseGrammar().GetAugmentedGrammar() : parser.ParseGrammar()) {
-        grammar_.InsertTerminal("$");
-        std::vector<std::tuple<std::string, ItemSet, ItemSet>> states_function = {};
-        std::map<ItemSet, ItemSet> states_map;
-
-        auto lr1_states = GenerateStates();
-        std::set<ItemSet> real_states;
-        while (!lr1_states.empty()) {
-            auto actual_state = *lr1_states.begin();
-            std::set<ItemSet> repeated = {actual_state};
-            for (auto &state : lr1_states) {
-                std::set<LR0::Item> s1, s2;
-                for (auto &item : actual_state)
-                    s1.insert(item.lr0_item);
-                for (auto &item : state)
-                    s2.insert(item.lr0_item);
-                if (s1 == s2)
-                    repeated.insert(state);
+        int start = (int) transitions.size();
+        transitions.emplace_back(0, grammar.Left(start_rule));
+
+        std::vector<grammar::TerminalSet> follow(transitions.size(), empty);
+        std::vector<std::vector<int>> reads(transitions.size());
+        for (int i = 0; i < start; ++i) {
+            int next_state = automaton.Goto(transitions[i].first, transitions[i].second);
+            for (const auto &[symbol, target] : automaton[next_state].transitions) {
+                if (grammar.IsTerminal(symbol))
+                    follow[i].Insert(symbol);
+                else if (grammar_.Nullable(symbol))
+                    reads[i].push_back(transition_ids[{next_state, symbol}]);
             }
-            ItemSet result;
-            for (auto &set : repeated) {
-                for (auto &item : set) {
-                    result.insert(item);
+        }
+        follow[start].Insert(grammar.end());
+        Digraph(reads, follow);
+
+        // Walks every rule of every transition, the states reached give the includes and lookback relations.
+        Reductions reductions(automaton.size());
+        std::vector<std::vector<int>> lookback;
+        std::map<std::pair<int, int>, int> reduction_ids;
+        std::vector<std::vector<int>> includes(transitions.size());
+        std::vector<int> path;
+        for (int i = 0; i < (int) transitions.size(); ++i) {
+            const auto &[state, variable] = transitions[i];
+            const auto rules = i == start ? grammar::Range<int>(&start_rule, &start_rule + 1) : grammar.Rules(variable);
+            for (int rule : rules) {
+                auto right = grammar.Right(rule);
+                path.assign(1, state);
+                for (auto symbol : right)
+                    path.push_back(automaton.Goto(path.back(), symbol));
+
+                for (int dot = (int) right.size() - 1; dot >= 0; --dot) {
+                    if (!grammar.IsTerminal(right[dot]))
+                        includes[transition_ids[{path[dot], right[dot]}]].push_back(i);
+                    if (grammar.IsTerminal(right[dot]) || !grammar_.Nullable(right[dot]))
+                        break;
+                }
+
+                auto [id, inserted] = reduction_ids.emplace(std::make_pair(path.back(), rule), (int) lookback.size());
+                if (inserted) {
+                    lookback.emplace_back();
+                    reductions[path.back()].emplace_back(rule, empty);
                 }
+                lookback[id->second].push_back(i);
             }
-            states_map[result] = result;
-            for(auto & set : repeated)
-                states_map[set] = result;
-            real_states.insert(result);
-            for (auto &state : repeated)
-                lr1_states.erase(state);
         }
+        Digraph(includes, follow);
 
-        for (const auto &actual_state : real_states) {
-            std::set<std::string> symbol_set;
-            for (const auto &item : actual_state) {
-                if (item.lr0_item.point < item.lr0_item.rule.size())
-                    symbol_set.insert(item.lr0_item.PointSymbol());
-            }
-            for (const auto &symbol : symbol_set) {
-                ItemSet new_state = ItemsClosure(goTo(actual_state, symbol));
-                if (!new_state.empty()) {
-                    states_function.emplace_back(symbol, actual_state, states_map[new_state]);
-                }
+        for (int state = 0; state < automaton.size(); ++state) {
+            for (auto &[rule, lookahead] : reductions[state]) {
+                for (int i : lookback[reduction_ids[{state, rule}]])
+                    lookahead.Merge(follow[i]);
             }
         }
-        CreateParsingTable(states_function);
+        return reductions;
     }
 
-    void LALR::CreateParsingTable(const std::vector<std::tuple<std::string, ItemSet, ItemSet>> &states_function) {
-        std::map<ItemSet, int> states_index;
-        std::set<int> analyzed;
+    void LALR::CreateParsingTable(const LR0Automaton &automaton, const Reductions &reductions, PackedItem accept_item) {
+        const auto &grammar = automaton.grammar();
+        states_number_ = automaton.size();
+        for (int state = 0; state < automaton.size(); ++state) {
+            for (const auto &[symbol, next_state] : automaton[state].transitions)
+                function_[{state, grammar.Name(symbol)}] = {grammar.IsTerminal(symbol) ? 's' : 'g', next_state};
 
-        std::vector<std::string> axiom_rule = *grammar_[grammar_.axiom()].begin();
-        Item accept_item = {{grammar_.axiom(), axiom_rule, 1}, "$"};
-
-        for (const auto &action : states_function) {
-            const auto&[symbol, initial_state, next_state] = action;
-            if (!states_index.count(initial_state)) {
-                states_number_++;
-                states_index[initial_state] = states_index.size();
-            }
-            if (!states_index.count(next_state)) {
-                states_number_++;
-                states_index[next_state] = states_index.size();
-            }
-            if (grammar_.terminals().count(symbol))
-                function_[{states_index[initial_state], symbol}] = {'s', states_index[next_state]};
-            else
-                function_[{states_index[initial_state], symbol}] = {'g', states_index[next_state]};
-            if (next_state.count(accept_item)) {
-                function_[{states_index[next_state], "$"}] = {'a', -1};
+            const auto &kernel = automaton[state].kernel.items;
+            if (std::binary_search(kernel.begin(), kernel.end(), accept_item)) {
+                function_[{state, "$"}] = {'a', -1};
                 continue;
             }
-            if (!analyzed.count(states_index[next_state])) {
-                analyzed.insert(states_index[next_state]);
 
-                std::map<std::string, int> symbol_r;
-                std::set<int> scanned_rules;
-                std::set<std::string> symbol_s;
-                for (const auto &item : next_state) {
-                    if (item.lr0_item.point == item.lr0_item.rule.size()) {
-                        if (symbol_r.count(item.token) &&
-                            symbol_r[item.token] !=
-                            grammar_.GetRuleIndex(item.lr0_item.variable, item.lr0_item.rule)) {
-                            ThrowConflictError(Conflict::kReduceReduceConflict,
-                                               {next_state, states_index[next_state]},
-                                               scanned_rules);
-                            number_of_conflicts_++;
-                        } else {
-                            symbol_r[item.token] = grammar_.GetRuleIndex(item.lr0_item.variable,
-                                                                         item.lr0_item.rule);
-                            scanned_rules.insert(symbol_r[item.token]);
-                        }
-                    } else if (grammar_.terminals().count(item.lr0_item.PointSymbol()))
-                        symbol_s.insert(item.lr0_item.PointSymbol());
-                    if (item.lr0_item.point == item.lr0_item.rule.size())
-                        function_[{states_index[next_state], item.token}] =
-                                {'r', grammar_.GetRuleIndex(item.lr0_item.variable, item.lr0_item.rule)};
-                }
-                for (const auto &item : symbol_s) {
-                    if (symbol_r.count(item)) {
-                        ThrowConflictError(Conflict::kShiftReduceConflict,
-                                           {next_state, states_index[next_state]},
-                                           {symbol_r[item]},
-                                           item);
+            std::map<int, int> symbol_r;
+            std::set<int> scanned_rules;
+            for (const auto &[rule, lookahead] : reductions[state]) {
+                lookahead.ForEach([&](int terminal) {
+                    if (symbol_r.count(terminal) && symbol_r[terminal] != rule) {
+                        ThrowConflictError(Conflict::kReduceReduceConflict, automaton, reductions, state,
+                                           scanned_rules);
                         number_of_conflicts_++;
+                    } else {
+                        symbol_r[terminal] = rule;
+                        scanned_rules.insert(rule);
                     }
+                    function_[{state, grammar.Name(terminal)}] = {'r', rule};
+                });
+            }
+            for (const auto &[symbol, next_state] : automaton[state].transitions) {
+                if (grammar.IsTerminal(symbol) && symbol_r.count(symbol) &&
+                    !ResolveShiftReduce(grammar, state, symbol, next_state)) {
+                    ThrowConflictError(Conflict::kShiftReduceConflict, automaton, reductions, state,
+                                       {symbol_r[symbol]}, grammar.Name(symbol));
+                    number_of_conflicts_++;
                 }
             }
         }
         if (number_of_conflicts_ > 0) {
-            std::cerr << "Found " + std::to_string(number_of_conflicts_) +
-                         " conflicts when creating the parsing table."
+            std::cerr << "Found " + std::to_string(number_of_conflicts_) + " conflicts when creating the parsing table."
                       << std::endl;
             std::cerr << "Stopping parsing..." << std::endl << std::endl;
             exit(-1);
@@ -324,7 +303,7 @@ namespace compiler::parsers {
                 } else if (action.first == 'r') {
                     auto rule = grammar_.GetRuleFromIndex(action.second);
 
-                    int rule_size = 2 * (int) rule.second.size();
+                    int rule_size = 2 * (int) grammar_.Freeze().Right(action.second).size();
                     std::string var_symbol = rule.first;
 
                     if (verbose) {
@@ -372,11 +351,12 @@ namespace compiler::parsers {
         return accept;
     }
 
-    void LALR::ThrowConflictError(ConflictManager::Conflict c, const std::pair<ItemSet, int> &print_obj,
+    void LALR::ThrowConflictError(ConflictManager::Conflict c, const LR0Automaton &automaton,
+                                  const Reductions &reductions, int state,
                                   const std::set<int> &rule_set, const std::string &symbol) {
         if (c == Conflict::kShiftReduceConflict) {
-            std::cerr << std::endl << "In state " << std::to_string(print_obj.second) << ":" << std::endl;
-            PrintItemSet(print_obj.first);
+            std::cerr << std::endl << "In state " << std::to_string(state) << ":" << std::endl;
+            PrintItemSet(automaton, reductions, state);
             std::cerr << std::endl;
             std::cerr << std::endl
                       << "Found Shift/Reduce conflict for symbol '" + symbol + "' caused by production(s): "
@@ -390,8 +370,8 @@ namespace compiler::parsers {
             }
             std::cerr << std::endl;
         } else if (c == Conflict::kReduceReduceConflict) {
-            std::cerr << std::endl << "In state " << std::to_string(print_obj.second) << ":" << std::endl;
-            PrintItemSet(print_obj.first);
+            std::cerr << std::endl << "In state " << std::to_string(state) << ":" << std::endl;
+            PrintItemSet(automaton, reductions, state);
             std::cerr << std::endl;
             std::cerr << std::endl
                       << "Found Reduce/Reduce conflict caused by production(s): "
@@ -407,24 +387,21 @@ namespace compiler::parsers {
         }
     }
 
-    void LALR::PrintItemSet(const LALR::ItemSet &set) {
-        std::vector<std::pair<LR0::Item, std::set<std::string>>> items;
-        for (const auto &it : set) {
-            if (!items.empty() && items.back().first == it.lr0_item)
-                items.back().second.insert(it.token);
-            else
-                items.push_back({it.lr0_item, {it.token}});
-        }
+    void LALR::PrintItemSet(const LR0Automaton &automaton, const Reductions &reductions, int state) {
+        const auto &grammar = automaton.grammar();
         std::string result;
-        for (const auto &it : items) {
-            result = "\t\t" + std::to_string(grammar_.GetRuleIndex(it.first.variable, it.first.rule)) +
-                     it.first.to_string() + "\t\t{";
-            for (const auto &it2 : it.second)
-                result += it2 + ", ";
-            result.pop_back();
-            result.pop_back();
-            result += "}\n";
-            std::cout << result << std::endl;
+        for (auto item : automaton.Closure(state)) {
+            result = "\t\t" + std::to_string(ItemRule(item)) + ItemString(grammar, item);
+            for (const auto &[rule, lookahead] : reductions[state]) {
+                if (automaton.NextSymbol(item) >= 0 || rule != ItemRule(item))
+                    continue;
+                result += "\t\t{";
+                lookahead.ForEach([&](int terminal) { result += grammar.Name(terminal) + ", "; });
+                result.pop_back();
+                result.pop_back();
+                result += "}";
+            }
+            std::cout << result << std::endl << std::endl;
         }
     }
 } // namespace compiler::parsers
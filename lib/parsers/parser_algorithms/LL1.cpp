@@ -199,6 +199,64 @@ namespace compiler::parsers {
         return accept;
     }
 
+    bool LL1::ParseTree(SyntaxTree &tree) {
+        tree.Clear();
+        auto terminals = grammar_.terminals();
+        terminals.insert("$");
+
+        // Every variable is followed in the stack by a closing entry that sets its number of tokens.
+        SyntaxNode end_node, *root = tree.NewNodes(1);
+        end_node.symbol = "$";
+        root->symbol = tree.Intern(grammar_.axiom());
+        std::vector<std::pair<SyntaxNode *, bool>> stack = {{&end_node, false}, {root, false}};
+
+        auto current_token = tokenizer_.yylex();
+        std::string saver = current_token.token_name;
+        if (!terminals.count(saver))
+            saver = current_token.lexeme;
+
+        while (true) {
+            auto [node, closing] = stack.back();
+            if (closing) {
+                node->token_count = tree.tokens().size() - node->first_token;
+                stack.pop_back();
+                continue;
+            }
+
+            auto action = function_.find({std::string(node->symbol), saver});
+            if (action == function_.end())
+                return false;
+            if (action->second == -2) {
+                tree.set_root(root);
+                return true;
+            }
+
+            stack.pop_back();
+            if (action->second == -1) {
+                node->first_token = tree.AddToken(std::move(current_token));
+                node->token_count = 1;
+                current_token = tokenizer_.yylex();
+                saver = current_token.token_name;
+                if (!terminals.count(saver))
+                    saver = current_token.lexeme;
+                continue;
+            }
+
+            const auto rule = grammar_.GetRuleFromIndex(action->second);
+            node->rule = action->second;
+            node->first_token = tree.tokens().size();
+            stack.emplace_back(node, true);
+            if (rule.second.front() == "#")
+                continue;
+            node->children = tree.NewNodes(rule.second.size());
+            node->child_count = rule.second.size();
+            for (std::size_t i = rule.second.size(); i-- > 0;) {
+                node->children[i].symbol = tree.Intern(rule.second[i]);
+                stack.emplace_back(node->children + i, false);
+            }
+        }
+    }
+
     void LL1::ThrowConflictError(Conflict c, const std::vector<int> &print_obj, const std::string &symbol) {
         if (c == Conflict::kFirstFirstConflict) {
             std::cerr << std::endl << "Found First/First conflict for symbol '" + symbol + "' caused by production(s): "
@@ -1,7 +1,6 @@
 #include "parsers/parser_algorithms/LR0.h"
 
 #include <algorithm>
-#include <stack>
 #include <iterator>
 
 
@@ -36,141 +35,46 @@ namespace compiler::parsers {
         return result;
     }
 
-    LR0::ItemSet LR0::ItemsClosure(const Item &item_input, ItemSet &calculated) {
-        if (calculated.count(item_input))
-            return {};
-        calculated.insert(item_input);
-        ItemSet closure_result = {item_input};
-        if (item_input.point < item_input.rule.size() && grammar_.non_terminals().count(item_input.PointSymbol())) {
-            auto rules = grammar_[item_input.PointSymbol()];
-            for (const auto &rule : rules) {
-                Item item_saver(item_input.PointSymbol(), rule);
-                auto closure_saver = ItemsClosure(item_saver, calculated);
-                if (!closure_saver.empty())
-                    closure_result.insert(closure_saver.begin(), closure_saver.end());
-            }
-        }
-        return closure_result;
-    }
-
-    LR0::ItemSet LR0::ItemsClosure(const ItemSet &input_items) {
-        ItemSet closure_result = {}, calculated = {};
-        for (const auto &item : input_items) {
-            auto closure_saver = ItemsClosure(item, calculated);
-            if (!closure_saver.empty())
-                closure_result.insert(closure_saver.begin(), closure_saver.end());
-        }
-        return closure_result;
-    }
-
-    LR0::ItemSet LR0::goTo(const ItemSet &input_items, const std::string &input_symbol) {
-        if (input_symbol == "$")
-            return {};
-        ItemSet goto_result = {};
-        for (const Item &item : input_items) {
-            if (item.point < item.rule.size() && item.PointSymbol() == input_symbol)
-                goto_result.insert(Item(item.variable, item.rule, item.point + 1));
-        }
-        goto_result = ItemsClosure(goto_result);
-        return goto_result;
-    }
-
-    LR0::LR0(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar) :
-            Parser(tokenizer, augment_grammar ? parser.ParseGrammar().GetAugmentedGrammar() : parser.ParseGrammar()) {
+    LR0::LR0(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar,
+                unsigned threads) :
+            LRParser(tokenizer, augment_grammar ? parser.ParseGrammar().GetAugmentedGrammar() : parser.ParseGrammar()) {
         grammar_.InsertTerminal("$");
-        std::vector<std::tuple<std::string, ItemSet, ItemSet>> states_function = {};
-
-        std::string ax_saver = grammar_.axiom();
-        auto rule_saver = *grammar_[ax_saver].begin();
-
-        Item axiom(ax_saver, rule_saver);
-
-        auto first_state = ItemsClosure({axiom});
-        std::stack<ItemSet> pending;
-        pending.push(first_state);
-        std::set<ItemSet> states_set = {first_state};
-
-        while (!pending.empty()) {
-            ItemSet actual_state = pending.top();
-            pending.pop();
-
-            std::set<std::string> symbol_set;
-            for (const auto &item : actual_state) {
-                if (item.point < item.rule.size())
-                    symbol_set.insert(item.PointSymbol());
-            }
-
-            for (const auto &symbol : symbol_set) {
-                ItemSet new_state = ItemsClosure(goTo(actual_state, symbol));
-                if (!new_state.empty()) {
-                    if (!states_set.count(new_state)) {
-                        pending.push(new_state);
-                        states_set.insert(new_state);
-                    }
-                    states_function.emplace_back(symbol, actual_state, new_state);
-                }
-            }
-        }
-        CreateParsingTable(states_function);
+        const auto &axiom_rule = *grammar_[grammar_.axiom()].begin();
+        int axiom_index = grammar_.GetRuleIndex(grammar_.axiom(), axiom_rule);
+        CreateParsingTable(LR0Automaton(grammar_.Freeze(), axiom_index, threads), PackItem(axiom_index, 1));
     }
 
-    void LR0::CreateParsingTable(const std::vector<std::tuple<std::string, ItemSet, ItemSet>> &states_function) {
-        std::map<ItemSet, int> states_index;
-        std::set<int> analyzed;
-
-        std::vector<std::string> axiom_rule = *grammar_[grammar_.axiom()].begin();
-        auto accept_item = Item(grammar_.axiom(), axiom_rule, 1);
+    void LR0::CreateParsingTable(const LR0Automaton &automaton, PackedItem accept_item) {
+        const auto &grammar = automaton.grammar();
+        states_number_ = automaton.size();
+        for (int state = 0; state < automaton.size(); ++state) {
+            for (const auto &[symbol, next_state] : automaton[state].transitions)
+                function_[{state, grammar.Name(symbol)}] = {grammar.IsTerminal(symbol) ? 's' : 'g', next_state};
 
-        for (const auto &action : states_function) {
-            const auto&[symbol, initial_state, next_state] = action;
-            if (!states_index.count(initial_state)) {
-                states_number_++;
-                states_index[initial_state] = states_index.size();
+            const auto &kernel = automaton[state].kernel.items;
+            if (std::binary_search(kernel.begin(), kernel.end(), accept_item)) {
+                function_[{state, "$"}] = {'a', -1};
+                continue;
             }
-            if (!states_index.count(next_state)) {
-                states_number_++;
-                states_index[next_state] = states_index.size();
+
+            std::set<int> symbol_r;
+            for (auto item : automaton.Closure(state)) {
+                if (automaton.NextSymbol(item) < 0)
+                    symbol_r.insert(ItemRule(item));
             }
-            if (grammar_.terminals().count(symbol))
-                function_[{states_index[initial_state], symbol}] = {'s', states_index[next_state]};
-            else
-                function_[{states_index[initial_state], symbol}] = {'g', states_index[next_state]};
-            if(next_state.count(accept_item)) {
-                function_[{states_index[next_state], "$"}] = {'a', -1};
+            if (symbol_r.empty())
                 continue;
+            for (int terminal = 0; terminal < grammar.terminal_count(); ++terminal)
+                function_[{state, grammar.Name(terminal)}] = {'r', *symbol_r.begin()};
+
+            if (symbol_r.size() > 1) {
+                ThrowConflictError(Conflict::kReduceReduceConflict, automaton, state, symbol_r);
+                number_of_conflicts_++;
             }
-            if(!analyzed.count(states_index[next_state])) {
-                analyzed.insert(states_index[next_state]);
-                if (next_state.size() == 1) {
-                    const auto &item = *next_state.begin();
-                    if (item.point == item.rule.size()) {
-                        for (const auto &terminal : grammar_.terminals()) {
-                            function_[{states_index[next_state], terminal}] =
-                                    {'r', grammar_.GetRuleIndex(item.variable, item.rule)};
-                        }
-                    }
-                } else {
-                    std::set<int> symbol_r;
-                    std::set<std::string> symbol_s;
-                    for (const auto &item : next_state) {
-                        if (item.point == item.rule.size())
-                            symbol_r.insert(grammar_.GetRuleIndex(item.variable, item.rule));
-                        else if (grammar_.terminals().count(item.PointSymbol()))
-                            symbol_s.insert(item.PointSymbol());
-                    }
-                    if (symbol_r.size() > 1) {
-                        ThrowConflictError(Conflict::kReduceReduceConflict,
-                                           {next_state, states_index[next_state]}, symbol_r);
-                        number_of_conflicts_++;
-                    }
-                    if (!symbol_s.empty() && !symbol_r.empty()) {
-                        for (const auto &sym : symbol_s) {
-                            ThrowConflictError(Conflict::kShiftReduceConflict,
-                                               {next_state, states_index[next_state]},
-                                               symbol_r, sym);
-                            number_of_conflicts_++;
-                        }
-                    }
+            for (const auto &[symbol, next_state] : automaton[state].transitions) {
+                if (grammar.IsTerminal(symbol) && !ResolveShiftReduce(grammar, state, symbol, next_state)) {
+                    ThrowConflictError(Conflict::kShiftReduceConflict, automaton, state, symbol_r, grammar.Name(symbol));
+                    number_of_conflicts_++;
                 }
             }
         }
@@ -293,7 +197,7 @@ namespace compiler::parsers {
                 } else if (action.first == 'r') {
                     auto rule = grammar_.GetRuleFromIndex(action.second);
 
-                    int rule_size = 2 * (int) rule.second.size();
+                    int rule_size = 2 * (int) grammar_.Freeze().Right(action.second).size();
                     std::string var_symbol = rule.first;
 
                     if (verbose) {
@@ -340,14 +244,12 @@ namespace compiler::parsers {
         return accept;
     }
 
-    void LR0::ThrowConflictError(ConflictManager::Conflict c, const std::pair<ItemSet, int> &print_obj,
+    void LR0::ThrowConflictError(ConflictManager::Conflict c, const LR0Automaton &automaton, int state,
                                  const std::set<int> &rule_set, const std::string &symbol) {
         if (c == Conflict::kShiftReduceConflict) {
-            std::cerr << std::endl << "In state " << std::to_string(print_obj.second) << ":" << std::endl;
-            for (const auto &item : print_obj.first) {
-                std::cerr << "\t" << std::to_string(grammar_.GetRuleIndex(item.variable, item.rule))
-                          << item.to_string() << std::endl;
-            }
+            std::cerr << std::endl << "In state " << std::to_string(state) << ":" << std::endl;
+            for (auto item : automaton.Closure(state))
+                std::cerr << "\t" << std::to_string(ItemRule(item)) << automaton.ItemString(item) << std::endl;
             std::cerr << std::endl;
             std::cerr << std::endl
                       << "Found Shift/Reduce conflict for symbol '" + symbol + "' caused by production(s): "
@@ -361,11 +263,9 @@ namespace compiler::parsers {
             }
             std::cerr << std::endl;
         } else if (c == Conflict::kReduceReduceConflict) {
-            std::cerr << std::endl << "In state " << std::to_string(print_obj.second) << ":" << std::endl;
-            for (const auto &item : print_obj.first) {
-                std::cerr << "\t" << std::to_string(grammar_.GetRuleIndex(item.variable, item.rule))
-                          << item.to_string() << std::endl;
-            }
+            std::cerr << std::endl << "In state " << std::to_string(state) << ":" << std::endl;
+            for (auto item : automaton.Closure(state))
+                std::cerr << "\t" << std::to_string(ItemRule(item)) << automaton.ItemString(item) << std::endl;
             std::cerr << std::endl;
             std::cerr << std::endl
                       << "Found Reduce/Reduce conflict caused by production(s): "
@@ -1,154 +1,57 @@
-#include <stack>
 #include <algorithm>
 #include "parsers/parser_algorithms/LR1.h"
 
 namespace compiler::parsers {
 
-    LR1::ItemSet LR1::ItemsClosure(const Item &item_input, ItemSet &calculated) {
-        if (calculated.count(item_input))
-            return {};
-        calculated.insert(item_input);
-        ItemSet closure_result = {item_input};
-        if (item_input.lr0_item.point < item_input.lr0_item.rule.size() &&
-            grammar_.non_terminals().count(item_input.lr0_item.PointSymbol())) {
-            auto rules = grammar_[item_input.lr0_item.PointSymbol()];
-            for (const auto &rule : rules) {
+    LR1::LR1(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar,
+             unsigned threads) :
+            LR1(std::move(parser), tokenizer, augment_grammar, LR1Automaton::Construction::kCanonical, threads) {}
 
-                std::vector<std::string> saver;
-                saver.insert(saver.end(), item_input.lr0_item.rule.begin() + item_input.lr0_item.point + 1,
-                             item_input.lr0_item.rule.end());
-                saver.push_back(item_input.token);
-
-                for (const auto &token : grammar_.First(saver)) {
-                    Item item_saver = {{item_input.lr0_item.PointSymbol(), rule, 0}, token};
-                    auto closure_saver = ItemsClosure(item_saver, calculated);
-                    if (!closure_saver.empty())
-                        closure_result.insert(closure_saver.begin(), closure_saver.end());
-                }
-            }
-        }
-        return closure_result;
-    }
-
-    LR1::ItemSet LR1::ItemsClosure(const ItemSet &input_items) {
-        ItemSet closure_result = {}, calculated = {};
-        for (const auto &item : input_items) {
-            auto closure_saver = ItemsClosure(item, calculated);
-            if (!closure_saver.empty())
-                closure_result.insert(closure_saver.begin(), closure_saver.end());
-        }
-        return closure_result;
-    }
-
-    LR1::ItemSet LR1::goTo(const ItemSet &input_items, const std::string &input_symbol) {
-        if (input_symbol == "$")
-            return {};
-        ItemSet goto_result = {};
-        for (const Item &item : input_items) {
-            if (item.lr0_item.point < item.lr0_item.rule.size() && item.lr0_item.PointSymbol() == input_symbol)
-                goto_result.insert({{item.lr0_item.variable, item.lr0_item.rule, item.lr0_item.point + 1}, item.token});
-        }
-        goto_result = ItemsClosure(goto_result);
-        return goto_result;
-    }
-
-    LR1::LR1(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar) :
-            Parser(tokenizer,
+    LR1::LR1(grammar::GrammarParser parser, analyzers::LexicalAnalyzer &tokenizer, bool augment_grammar,
+             LR1Automaton::Construction construction, unsigned threads) :
+            LRParser(tokenizer,
                    augment_grammar ? parser.ParseGrammar().GetAugmentedGrammar() : parser.ParseGrammar()) {
         grammar_.InsertTerminal("$");
-        std::vector<std::tuple<std::string, ItemSet, ItemSet>> states_function = {};
-
-        std::string ax_saver = grammar_.axiom();
-        auto rule_saver = *grammar_[ax_saver].begin();
-
-        Item axiom = {{ax_saver, rule_saver, 0}, "$"};
-
-        auto first_state = ItemsClosure({axiom});
-        std::stack<ItemSet> pending;
-        pending.push(first_state);
-        std::set<ItemSet> states_set = {first_state};
-
-        while (!pending.empty()) {
-            ItemSet actual_state = pending.top();
-            pending.pop();
-
-            std::set<std::string> symbol_set;
-            for (const auto &item : actual_state) {
-                if (item.lr0_item.point < item.lr0_item.rule.size())
-                    symbol_set.insert(item.lr0_item.PointSymbol());
-            }
-
-            for (const auto &symbol : symbol_set) {
-                ItemSet new_state = ItemsClosure(goTo(actual_state, symbol));
-                if (!new_state.empty()) {
-                    if (!states_set.count(new_state)) {
-                        pending.push(new_state);
-                        states_set.insert(new_state);
-                    }
-                    states_function.emplace_back(symbol, actual_state, new_state);
-                }
-            }
-        }
-        CreateParsingTable(states_function);
+        const auto &axiom_rule = *grammar_[grammar_.axiom()].begin();
+        int axiom_index = grammar_.GetRuleIndex(grammar_.axiom(), axiom_rule);
+        CreateParsingTable(LR1Automaton(grammar_, axiom_index, construction, threads), PackItem(axiom_index, 1));
     }
 
-    void LR1::CreateParsingTable(const std::vector<std::tuple<std::string, ItemSet, ItemSet>> &states_function) {
-        std::map<ItemSet, int> states_index;
-        std::set<int> analyzed;
-
-        std::vector<std::string> axiom_rule = *grammar_[grammar_.axiom()].begin();
-        Item accept_item = {{grammar_.axiom(), axiom_rule, 1}, "$"};
-
-        for (const auto &action : states_function) {
-            const auto&[symbol, initial_state, next_state] = action;
-            if (!states_index.count(initial_state)) {
-                states_number_++;
-                states_index[initial_state] = states_index.size();
-            }
-            if (!states_index.count(next_state)) {
-                states_number_++;
-                states_index[next_state] = states_index.size();
-            }
-            if (grammar_.terminals().count(symbol))
-                function_[{states_index[initial_state], symbol}] = {'s', states_index[next_state]};
-            else
-                function_[{states_index[initial_state], symbol}] = {'g', states_index[next_state]};
-            if (next_state.count(accept_item)) {
-                function_[{states_index[next_state], "$"}] = {'a', -1};
+    void LR1::CreateParsingTable(const LR1Automaton &automaton, PackedItem accept_item) {
+        const auto &grammar = automaton.grammar();
+        states_number_ = automaton.size();
+        for (int state = 0; state < automaton.size(); ++state) {
+            for (const auto &[symbol, next_state] : automaton[state].transitions)
+                function_[{state, grammar.Name(symbol)}] = {grammar.IsTerminal(symbol) ? 's' : 'g', next_state};
+
+            const auto &kernel = automaton[state].kernel.items;
+            auto accept = std::find_if(kernel.begin(), kernel.end(),
+                                       [&](const LR1Item &item) { return item.first == accept_item; });
+            if (accept != kernel.end() && accept->second.Contains(grammar.end())) {
+                function_[{state, "$"}] = {'a', -1};
                 continue;
             }
-            if (!analyzed.count(states_index[next_state])) {
-                analyzed.insert(states_index[next_state]);
 
-                std::map<std::string, int> symbol_r;
-                std::set<int> scanned_rules;
-                std::set<std::string> symbol_s;
-                for (const auto &item : next_state) {
-                    if (item.lr0_item.point == item.lr0_item.rule.size()) {
-                        if (symbol_r.count(item.token) &&
-                            symbol_r[item.token] != grammar_.GetRuleIndex(item.lr0_item.variable, item.lr0_item.rule)) {
-                            ThrowConflictError(Conflict::kReduceReduceConflict,
-                                               {next_state, states_index[next_state]},
-                                               scanned_rules);
-                            number_of_conflicts_++;
-                        } else {
-                            symbol_r[item.token] = grammar_.GetRuleIndex(item.lr0_item.variable, item.lr0_item.rule);
-                            scanned_rules.insert(symbol_r[item.token]);
-                        }
-                    } else if (grammar_.terminals().count(item.lr0_item.PointSymbol()))
-                        symbol_s.insert(item.lr0_item.PointSymbol());
-                    if (item.lr0_item.point == item.lr0_item.rule.size())
-                        function_[{states_index[next_state], item.token}] =
-                                {'r', grammar_.GetRuleIndex(item.lr0_item.variable, item.lr0_item.rule)};
-                }
-                for (const auto &item : symbol_s) {
-                    if (symbol_r.count(item)) {
-                        ThrowConflictError(Conflict::kShiftReduceConflict,
-                                           {next_state, states_index[next_state]},
-                                           {symbol_r[item]},
-                                           item);
+            std::map<int, int> symbol_r;
+            std::set<int> scanned_rules;
+            for (const auto &[rule, lookahead] : automaton[state].reductions) {
+                lookahead.ForEach([&](int terminal) {
+                    if (symbol_r.count(terminal) && symbol_r[terminal] != rule) {
+                        ThrowConflictError(Conflict::kReduceReduceConflict, automaton, state, scanned_rules);
                         number_of_conflicts_++;
+                    } else {
+                        symbol_r[terminal] = rule;
+                        scanned_rules.insert(rule);
                     }
+                    function_[{state, grammar.Name(terminal)}] = {'r', rule};
+                });
+            }
+            for (const auto &[symbol, next_state] : automaton[state].transitions) {
+                if (grammar.IsTerminal(symbol) && symbol_r.count(symbol) &&
+                    !ResolveShiftReduce(grammar, state, symbol, next_state)) {
+                    ThrowConflictError(Conflict::kShiftReduceConflict, automaton, state, {symbol_r[symbol]},
+                                       grammar.Name(symbol));
+                    number_of_conflicts_++;
                 }
             }
         }
@@ -273,7 +176,7 @@ namespace compiler::parsers {
                 } else if (action.first == 'r') {
                     auto rule = grammar_.GetRuleFromIndex(action.second);
 
-                    int rule_size = 2 * (int) rule.second.size();
+                    int rule_size = 2 * (int) grammar_.Freeze().Right(action.second).size();
                     std::string var_symbol = rule.first;
 
                     if (verbose) {
@@ -320,11 +223,11 @@ namespace compiler::parsers {
         return accept;
     }
 
-    void LR1::ThrowConflictError(ConflictManager::Conflict c, const std::pair<ItemSet, int> &print_obj,
+    void LR1::ThrowConflictError(ConflictManager::Conflict c, const LR1Automaton &automaton, int state,
                                  const std::set<int> &rule_set, const std::string &symbol) {
         if (c == Conflict::kShiftReduceConflict) {
-            std::cerr << std::endl << "In state " << std::to_string(print_obj.second) << ":" << std::endl;
-            PrintItemSet(print_obj.first);
+            std::cerr << std::endl << "In state " << std::to_string(state) << ":" << std::endl;
+            PrintItemSet(automaton, state);
             std::cerr << std::endl;
             std::cerr << std::endl
                       << "Found Shift/Reduce conflict for symbol '" + symbol + "' caused by production(s): "
@@ -338,8 +241,8 @@ namespace compiler::parsers {
             }
             std::cerr << std::endl;
         } else if (c == Conflict::kReduceReduceConflict) {
-            std::cerr << std::endl << "In state " << std::to_string(print_obj.second) << ":" << std::endl;
-            PrintItemSet(print_obj.first);
+            std::cerr << std::endl << "In state " << std::to_string(state) << ":" << std::endl;
+            PrintItemSet(automaton, state);
             std::cerr << std::endl;
             std::cerr << std::endl
                       << "Found Reduce/Reduce conflict caused by production(s): "
@@ -355,20 +258,12 @@ namespace compiler::parsers {
         }
     }
 
-    void LR1::PrintItemSet(const LR1::ItemSet &set) {
-        std::vector<std::pair<LR0::Item, std::set<std::string>>> items;
-        for (const auto &it : set) {
-            if (!items.empty() && items.back().first == it.lr0_item)
-                items.back().second.insert(it.token);
-            else
-                items.push_back({it.lr0_item, {it.token}});
-        }
+    void LR1::PrintItemSet(const LR1Automaton &automaton, int state) {
+        const auto &grammar = automaton.grammar();
         std::string result;
-        for (const auto &it : items) {
-            result = "\t\t" + std::to_string(grammar_.GetRuleIndex(it.first.variable, it.first.rule)) +
-                     it.first.to_string() + "\t\t{";
-            for (const auto &it2 : it.second)
-                result += it2 + ", ";
+        for (const auto &[item, lookahead] : automaton.Closure(state)) {
+            result = "\t\t" + std::to_string(ItemRule(item)) + ItemString(grammar, item) + "\t\t{";
+            lookahead.ForEach([&](int terminal) { result += grammar.Name(terminal) + ", "; });
             result.pop_back();
             result.pop_back();
             result += "}\n";
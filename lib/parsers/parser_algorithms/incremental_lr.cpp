@@ -0,0 +1,111 @@
+#include "parsers/parser_algorithms/incremental_lr.h"
+
+namespace compiler::parsers {
+
+    namespace {
+        // Index after the edit of the old token @p old, tokens removed by the edit go to its first new token.
+        std::size_t MapToken(std::size_t old, const analyzers::TokenEdit &edit) {
+            if (old < edit.first)
+                return old;
+            if (old < edit.first + edit.removed)
+                return edit.first;
+            return old - edit.removed + edit.inserted;
+        }
+    }
+
+    IncrementalLR::IncrementalLR(const Parser<LRTable> &parser) :
+            function_(parser.parsing_table()),
+            grammar_(parser.grammar_array()) {}
+
+    bool IncrementalLR::Parse(const std::vector<analyzers::TokenSpan> &tokens) {
+        root_ = nullptr;
+        return Run(tokens, {0, 0, tokens.size()});
+    }
+
+    bool IncrementalLR::Reparse(const std::vector<analyzers::TokenSpan> &tokens, const analyzers::TokenEdit &edit) {
+        return Run(tokens, edit);
+    }
+
+    std::string IncrementalLR::Lookahead(const std::vector<analyzers::TokenSpan> &tokens, std::size_t position) const {
+        if (position == tokens.size())
+            return "$";
+        const analyzers::Token &token = tokens[position].token;
+        return grammar_.terminals().count(token.token_name) ? token.token_name : token.lexeme;
+    }
+
+    IncrementalLR::NodePtr IncrementalLR::NextSubtree(std::vector<Pending> &pending, const analyzers::TokenEdit &edit,
+                                                      std::size_t position, int state) const {
+        while (!pending.empty()) {
+            Pending next = pending.back();
+            if (MapToken(next.first, edit) > position)
+                return nullptr;
+            pending.pop_back();
+
+            std::size_t end = next.first + next.node->tokens;
+            bool unchanged = end < edit.first || next.first >= edit.first + edit.removed;
+            if (unchanged && MapToken(next.first, edit) == position && next.node->rule != -1 &&
+                next.node->tokens != 0 && next.node->state == state) {
+                auto go_to = function_.find({state, next.node->symbol});
+                if (go_to != function_.end() && go_to->second.first == 'g')
+                    return next.node;
+            }
+            if (MapToken(end, edit) <= position)
+                continue;
+            for (auto child = next.node->children.rbegin(); child != next.node->children.rend(); ++child) {
+                end -= (*child)->tokens;
+                pending.push_back({*child, end});
+            }
+        }
+        return nullptr;
+    }
+
+    bool IncrementalLR::Run(const std::vector<analyzers::TokenSpan> &tokens, const analyzers::TokenEdit &edit) {
+        std::vector<Pending> pending;
+        if (root_)
+            pending.push_back({root_, 0});
+        root_ = nullptr;
+        reused_nodes_ = 0;
+
+        std::vector<std::pair<int, NodePtr>> stack = {{0, nullptr}};
+        std::size_t position = 0;
+        while (true) {
+            std::string symbol = Lookahead(tokens, position);
+            auto action = function_.find({stack.back().first, symbol});
+            if (action == function_.end())
+                return false;
+
+            if (action->second.first == 'a') {
+                root_ = stack.back().second;
+                return true;
+            } else if (action->second.first == 'r') {
+                auto rule = grammar_.GetRuleFromIndex(action->second.second);
+                auto rule_size = grammar_.Freeze().Right(action->second.second).size();
+                Node node = {rule.first, action->second.second, 0, 0, {}};
+                for (auto it = stack.end() - (long) rule_size; it != stack.end(); ++it) {
+                    node.tokens += it->second->tokens;
+                    node.children.push_back(it->second);
+                }
+                stack.resize(stack.size() - rule_size);
+                node.state = stack.back().first;
+
+                auto go_to = function_.find({node.state, rule.first});
+                if (go_to == function_.end() || go_to->second.first != 'g')
+                    return false;
+                stack.emplace_back(go_to->second.second, std::make_shared<const Node>(std::move(node)));
+            } else if (action->second.first == 's') {
+                int state = stack.back().first;
+                if (NodePtr subtree = NextSubtree(pending, edit, position, state)) {
+                    stack.emplace_back(function_.at({state, subtree->symbol}).second, subtree);
+                    position += subtree->tokens;
+                    reused_nodes_++;
+                    continue;
+                }
+                stack.emplace_back(action->second.second,
+                                   std::make_shared<const Node>(Node{symbol, -1, state, 1, {}}));
+                position++;
+            } else {
+                return false;
+            }
+        }
+    }
+} // namespace compiler::parsers
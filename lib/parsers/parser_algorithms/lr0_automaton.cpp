@@ -0,0 +1,114 @@
+#include "parsers/parser_algorithms/lr0_automaton.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "parsers/parser_algorithms/parallel_collection.h"
+
+namespace compiler::parsers {
+
+    Kernel::Kernel(std::vector<PackedItem> items) : items(std::move(items)) {
+        std::sort(this->items.begin(), this->items.end());
+        hash = this->items.size();
+        for (auto item : this->items)
+            hash ^= std::hash<PackedItem>()(item) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+
+    LR0Automaton::LR0Automaton(const grammar::FrozenGrammar &grammar, int start_rule, unsigned threads) :
+            grammar_(&grammar) {
+        Kernel initial({PackItem(start_rule, 0)});
+        if (threads != 1) {
+            std::vector<BuildBuffers> buffers(threads ? threads : std::max(1u, std::thread::hardware_concurrency()));
+            for (auto &worker_buffers : buffers)
+                worker_buffers.advanced.resize(grammar.symbol_count());
+            states_ = ParallelCollection<State, KernelHash>::Build(
+                    std::move(initial), (unsigned) buffers.size(), [&](State &state, auto &successor, unsigned worker) {
+                        Advance(state.kernel, buffers[worker]);
+                        for (auto symbol : buffers[worker].symbols) {
+                            Kernel kernel(std::move(buffers[worker].advanced[symbol]));
+                            buffers[worker].advanced[symbol].clear();
+                            state.transitions.emplace_back(symbol, successor(std::move(kernel)));
+                        }
+                    });
+            return;
+        }
+
+        states_.push_back({initial, {}});
+        state_ids_.emplace(std::move(initial), 0);
+        BuildBuffers buffers;
+        buffers.advanced.resize(grammar.symbol_count());
+        for (int state = 0; state < size(); ++state) {
+            Advance(states_[state].kernel, buffers);
+            for (auto symbol : buffers.symbols) {
+                Kernel kernel(std::move(buffers.advanced[symbol]));
+                buffers.advanced[symbol].clear();
+                auto [id, inserted] = state_ids_.emplace(std::move(kernel), size());
+                if (inserted)
+                    states_.push_back({id->first, {}});
+                states_[state].transitions.emplace_back(symbol, id->second);
+            }
+        }
+    }
+
+    void LR0Automaton::Advance(const Kernel &kernel, BuildBuffers &buffers) const {
+        buffers.items = kernel.items;
+        Closure(buffers.items, buffers.added);
+
+        buffers.symbols.clear();
+        for (auto item : buffers.items) {
+            Symbol symbol = NextSymbol(item);
+            if (symbol < 0)
+                continue;
+            if (buffers.advanced[symbol].empty())
+                buffers.symbols.push_back(symbol);
+            buffers.advanced[symbol].push_back(item + 1);
+        }
+        std::sort(buffers.symbols.begin(), buffers.symbols.end());
+    }
+
+    int LR0Automaton::Goto(int state, Symbol symbol) const {
+        const auto &transitions = states_[state].transitions;
+        auto transition = std::lower_bound(transitions.begin(), transitions.end(), std::make_pair(symbol, -1));
+        return transition != transitions.end() && transition->first == symbol ? transition->second : -1;
+    }
+
+    std::vector<PackedItem> LR0Automaton::Closure(int state) const {
+        std::vector<PackedItem> items = states_[state].kernel.items;
+        std::vector<char> added;
+        Closure(items, added);
+        return items;
+    }
+
+    void LR0Automaton::Closure(std::vector<PackedItem> &items, std::vector<char> &added) const {
+        // Items are appended while they are read, every variable adds its rules once.
+        added.assign(grammar_->variable_count(), 0);
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            Symbol symbol = NextSymbol(items[i]);
+            if (symbol < 0 || grammar_->IsTerminal(symbol) || added[grammar_->VariableIndex(symbol)])
+                continue;
+            added[grammar_->VariableIndex(symbol)] = 1;
+            for (int rule : grammar_->Rules(symbol))
+                items.push_back(PackItem(rule, 0));
+        }
+    }
+
+    grammar::FrozenGrammar::Symbol NextSymbol(const grammar::FrozenGrammar &grammar, PackedItem item) {
+        auto right = grammar.Right(ItemRule(item));
+        return ItemDot(item) < (int) right.size() ? right[ItemDot(item)] : -1;
+    }
+
+    std::string ItemString(const grammar::FrozenGrammar &grammar, PackedItem item) {
+        std::string output = ".- " + grammar.Name(grammar.Left(ItemRule(item))) + " -> ";
+        auto right = grammar.Right(ItemRule(item));
+        for (int i = 0; i < (int) right.size(); ++i) {
+            if (ItemDot(item) == i)
+                output += ". ";
+            output += grammar.Name(right[i]) + " ";
+        }
+        if (ItemDot(item) == (int) right.size())
+            output += ".";
+        else
+            output.pop_back();
+        return output;
+    }
+} // namespace compiler::parsers
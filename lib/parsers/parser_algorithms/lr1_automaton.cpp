@@ -0,0 +1,292 @@
+#include "parsers/parser_algorithms/lr1_automaton.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "parsers/parser_algorithms/parallel_collection.h"
+
+namespace compiler::parsers {
+
+    LR1Kernel::LR1Kernel(std::vector<LR1Item> items) : items(std::move(items)) {
+        auto &sorted = this->items;
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const LR1Item &a, const LR1Item &b) { return a.first < b.first; });
+        std::size_t last = 0;
+        for (std::size_t i = 1; i < sorted.size(); ++i) {
+            if (sorted[i].first == sorted[last].first)
+                sorted[last].second.Merge(sorted[i].second);
+            else if (++last != i)
+                sorted[last] = std::move(sorted[i]);
+        }
+        if (!sorted.empty())
+            sorted.resize(last + 1);
+
+        hash = sorted.size();
+        for (const auto &[item, lookahead] : sorted) {
+            hash ^= std::hash<PackedItem>()(item) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+            hash ^= lookahead.Hash() + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        }
+    }
+
+    LR1Automaton::LR1Automaton(grammar::GrammarArray &grammar, int start_rule, Construction construction,
+                               unsigned threads) :
+            grammar_(&grammar.Freeze()), construction_(construction) {
+        for (int i = 0; i < grammar_->variable_count(); ++i) {
+            nullable_.push_back(grammar.Nullable(grammar_->terminal_count() + i));
+            first_.push_back(grammar.FirstSet(grammar_->terminal_count() + i));
+        }
+
+        grammar::TerminalSet end(grammar_->terminal_count());
+        end.Insert(grammar_->end());
+        LR1Kernel initial({{PackItem(start_rule, 0), end}});
+        if (construction == Construction::kCanonical && threads != 1) {
+            std::vector<BuildBuffers> buffers(threads ? threads : std::max(1u, std::thread::hardware_concurrency()));
+            for (auto &worker_buffers : buffers)
+                worker_buffers.advanced.resize(grammar_->symbol_count());
+            states_ = ParallelCollection<State, LR1KernelHash>::Build(
+                    std::move(initial), (unsigned) buffers.size(), [&](State &state, auto &successor, unsigned worker) {
+                        Advance(state, buffers[worker]);
+                        for (auto symbol : buffers[worker].symbols) {
+                            LR1Kernel kernel(std::move(buffers[worker].advanced[symbol]));
+                            buffers[worker].advanced[symbol].clear();
+                            state.transitions.emplace_back(symbol, successor(std::move(kernel)));
+                        }
+                    });
+            return;
+        }
+
+        BuildBuffers buffers;
+        buffers.advanced.resize(grammar_->symbol_count());
+        FindState(std::move(initial), buffers);
+        for (std::size_t next = 0; next < buffers.pending.size(); ++next) {
+            int state = buffers.pending[next];
+            buffers.queued[state] = 0;
+            Expand(state, buffers);
+        }
+        if (construction == Construction::kPager)
+            RemoveUnreachable();
+    }
+
+    void LR1Automaton::Advance(State &state, BuildBuffers &buffers) const {
+        Closure(state.kernel, buffers.closure, buffers.items);
+
+        auto &advanced = buffers.advanced;
+        state.reductions.clear();
+        buffers.symbols.clear();
+        for (auto &[item, lookahead] : buffers.items) {
+            Symbol symbol = NextSymbol(*grammar_, item);
+            if (symbol < 0) {
+                state.reductions.emplace_back(ItemRule(item), std::move(lookahead));
+                continue;
+            }
+            if (advanced[symbol].empty())
+                buffers.symbols.push_back(symbol);
+            advanced[symbol].emplace_back(item + 1, std::move(lookahead));
+        }
+        std::sort(buffers.symbols.begin(), buffers.symbols.end());
+    }
+
+    void LR1Automaton::Expand(int state, BuildBuffers &buffers) {
+        Advance(states_[state], buffers);
+
+        // A state expanded again has the same core, so the same symbols in the same order as its transitions. The
+        // lookaheads it sends to a successor grew, so they may no longer be compatible with the ones merged there.
+        auto &advanced = buffers.advanced;
+        const auto &symbols = buffers.symbols;
+        bool expanded = !states_[state].transitions.empty();
+        for (std::size_t i = 0; i < symbols.size(); ++i) {
+            LR1Kernel kernel(std::move(advanced[symbols[i]]));
+            advanced[symbols[i]].clear();
+            if (expanded) {
+                int next_state = states_[state].transitions[i].second;
+                if (WeaklyCompatible(states_[next_state].kernel, kernel))
+                    MergeInto(next_state, kernel, buffers);
+                else
+                    states_[state].transitions[i].second = FindState(std::move(kernel), buffers);
+            } else {
+                int next_state = FindState(std::move(kernel), buffers);
+                states_[state].transitions.emplace_back(symbols[i], next_state);
+            }
+        }
+    }
+
+    int LR1Automaton::FindState(LR1Kernel kernel, BuildBuffers &buffers) {
+        if (construction_ == Construction::kCanonical) {
+            auto [id, inserted] = state_ids_.emplace(std::move(kernel), size());
+            if (inserted) {
+                states_.push_back({id->first, {}, {}});
+                Queue(id->second, buffers);
+            }
+            return id->second;
+        }
+
+        std::vector<PackedItem> core;
+        for (const auto &item : kernel.items)
+            core.push_back(item.first);
+        auto &candidates = cores_[Kernel(std::move(core))];
+        for (int candidate : candidates) {
+            if (WeaklyCompatible(states_[candidate].kernel, kernel)) {
+                MergeInto(candidate, kernel, buffers);
+                return candidate;
+            }
+        }
+        candidates.push_back(size());
+        states_.push_back({std::move(kernel), {}, {}});
+        Queue(size() - 1, buffers);
+        return size() - 1;
+    }
+
+    void LR1Automaton::MergeInto(int state, const LR1Kernel &kernel, BuildBuffers &buffers) {
+        auto &items = states_[state].kernel.items;
+        bool grew = false;
+        for (std::size_t i = 0; i < items.size(); ++i)
+            grew = items[i].second.Merge(kernel.items[i].second) || grew;
+        if (grew) {
+            states_[state].kernel = LR1Kernel(std::move(items));
+            Queue(state, buffers);
+        }
+    }
+
+    void LR1Automaton::RemoveUnreachable() {
+        std::vector<char> reached(states_.size(), 0);
+        std::vector<int> pending = {0};
+        reached[0] = 1;
+        while (!pending.empty()) {
+            int state = pending.back();
+            pending.pop_back();
+            for (const auto &transition : states_[state].transitions) {
+                if (!reached[transition.second]) {
+                    reached[transition.second] = 1;
+                    pending.push_back(transition.second);
+                }
+            }
+        }
+
+        // The states left keep their order, so state 0 is still the initial one.
+        std::vector<int> number(states_.size(), -1);
+        int count = 0;
+        for (int state = 0; state < size(); ++state) {
+            if (reached[state])
+                number[state] = count++;
+        }
+        if (count == size())
+            return;
+        std::vector<State> states;
+        states.reserve(count);
+        for (int state = 0; state < size(); ++state) {
+            if (!reached[state])
+                continue;
+            states.push_back(std::move(states_[state]));
+            for (auto &transition : states.back().transitions)
+                transition.second = number[transition.second];
+        }
+        states_ = std::move(states);
+        cores_.clear();
+    }
+
+    void LR1Automaton::Queue(int state, BuildBuffers &buffers) {
+        if ((int) buffers.queued.size() <= state)
+            buffers.queued.resize(state + 1, 0);
+        if (!buffers.queued[state]) {
+            buffers.queued[state] = 1;
+            buffers.pending.push_back(state);
+        }
+    }
+
+    bool LR1Automaton::WeaklyCompatible(const LR1Kernel &a, const LR1Kernel &b) {
+        // Pager's test, terminal by terminal: items i and j may share a lookahead through the merge only when they
+        // already share it in one of the kernels, so the merge adds no conflict, not even on a grammar that has some.
+        for (std::size_t i = 0; i < a.items.size(); ++i) {
+            for (std::size_t j = 0; j < a.items.size(); ++j) {
+                if (i == j)
+                    continue;
+                const auto &a_i = a.items[i].second, &a_j = a.items[j].second;
+                const auto &b_i = b.items[i].second, &b_j = b.items[j].second;
+                if (!a_i.Intersects(b_j))
+                    continue;
+                bool compatible = true;
+                a_i.ForEach([&](int terminal) {
+                    compatible = compatible && (!b_j.Contains(terminal) || a_j.Contains(terminal) ||
+                                                b_i.Contains(terminal));
+                });
+                if (!compatible)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    int LR1Automaton::Goto(int state, Symbol symbol) const {
+        const auto &transitions = states_[state].transitions;
+        auto transition = std::lower_bound(transitions.begin(), transitions.end(), std::make_pair(symbol, -1));
+        return transition != transitions.end() && transition->first == symbol ? transition->second : -1;
+    }
+
+    std::vector<LR1Item> LR1Automaton::Closure(int state) const {
+        ClosureBuffers buffers;
+        std::vector<LR1Item> items;
+        Closure(states_[state].kernel, buffers, items);
+        return items;
+    }
+
+    void LR1Automaton::Closure(const LR1Kernel &kernel, ClosureBuffers &buffers, std::vector<LR1Item> &items) const {
+        const auto &grammar = *grammar_;
+        if (buffers.lookaheads.size() != (std::size_t) grammar.variable_count()) {
+            buffers.lookaheads.assign(grammar.variable_count(), grammar::TerminalSet(grammar.terminal_count()));
+            buffers.added.assign(grammar.variable_count(), 0);
+            buffers.queued.assign(grammar.variable_count(), 0);
+        }
+
+        // The items of a variable added by the closure all have the same lookaheads: the first of what follows the
+        // variable in the items that added it, plus their lookaheads when that can generate epsilon.
+        auto spread = [&](PackedItem item, const grammar::TerminalSet &lookahead) {
+            auto right = grammar.Right(ItemRule(item));
+            int dot = ItemDot(item);
+            if (dot >= (int) right.size() || grammar.IsTerminal(right[dot]))
+                return;
+            int variable = grammar.VariableIndex(right[dot]);
+            auto &target = buffers.lookaheads[variable];
+            bool changed = !buffers.added[variable];
+            if (!buffers.added[variable]) {
+                buffers.added[variable] = 1;
+                buffers.order.push_back(variable);
+            }
+            bool nullable = true;
+            for (int i = dot + 1; nullable && i < (int) right.size(); ++i) {
+                if (grammar.IsTerminal(right[i])) {
+                    changed = changed || !target.Contains(right[i]);
+                    target.Insert(right[i]);
+                    nullable = false;
+                } else {
+                    changed = target.Merge(first_[grammar.VariableIndex(right[i])]) || changed;
+                    nullable = nullable_[grammar.VariableIndex(right[i])];
+                }
+            }
+            if (nullable)
+                changed = target.Merge(lookahead) || changed;
+            if (changed && !buffers.queued[variable]) {
+                buffers.queued[variable] = 1;
+                buffers.pending.push_back(variable);
+            }
+        };
+
+        for (const auto &[item, lookahead] : kernel.items)
+            spread(item, lookahead);
+        while (!buffers.pending.empty()) {
+            int variable = buffers.pending.back();
+            buffers.pending.pop_back();
+            buffers.queued[variable] = 0;
+            for (int rule : grammar.Rules(grammar.terminal_count() + variable))
+                spread(PackItem(rule, 0), buffers.lookaheads[variable]);
+        }
+
+        items.assign(kernel.items.begin(), kernel.items.end());
+        for (int variable : buffers.order) {
+            for (int rule : grammar.Rules(grammar.terminal_count() + variable))
+                items.emplace_back(PackItem(rule, 0), buffers.lookaheads[variable]);
+            buffers.lookaheads[variable].Clear();
+            buffers.added[variable] = 0;
+        }
+        buffers.order.clear();
+    }
+} // namespace compiler::parsers
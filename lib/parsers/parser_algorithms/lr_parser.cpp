@@ -0,0 +1,133 @@
+#include "parsers/parser_algorithms/lr_parser.h"
+
+#include <set>
+
+namespace compiler::parsers {
+
+    namespace {
+        // Builds the nodes of a SyntaxTree as semantic values.
+        struct TreeActions {
+            using Value = SyntaxNode;
+
+            SyntaxTree &tree;
+            const grammar::GrammarArray &grammar;
+            std::map<int, std::string_view> variables;
+
+            SyntaxNode Shift(const analyzers::Token &token) {
+                SyntaxNode leaf;
+                leaf.symbol = tree.Intern(grammar.terminals().count(token.token_name) ? token.token_name
+                                                                                      : token.lexeme);
+                leaf.first_token = tree.AddToken(token);
+                leaf.token_count = 1;
+                return leaf;
+            }
+
+            SyntaxNode Reduce(int rule, ValueSpan<SyntaxNode> children) {
+                auto variable = variables.find(rule);
+                if (variable == variables.end())
+                    variable = variables.emplace(rule, tree.Intern(grammar.GetRuleFromIndex(rule).first)).first;
+
+                SyntaxNode node;
+                node.symbol = variable->second;
+                node.rule = rule;
+                node.children = tree.NewNodes(children.size());
+                node.child_count = children.size();
+                node.first_token = children.empty() ? tree.tokens().size() : children[0].first_token;
+                for (std::size_t i = 0; i < children.size(); ++i) {
+                    node.children[i] = children[i];
+                    node.token_count += children[i].token_count;
+                }
+                return node;
+            }
+        };
+    }
+
+    const std::pair<std::string, std::size_t> &LRParser::Reduction(int rule) {
+        if (reductions_.empty()) {
+            const auto &grammar = grammar_.Freeze();
+            for (int i = 0; i < grammar.rule_count(); ++i)
+                reductions_.emplace_back(grammar.Name(grammar.Left(i)), grammar.Right(i).size());
+        }
+        return reductions_.at(rule);
+    }
+
+    int LRParser::EliminateUnitReductions() {
+        const auto &grammar = grammar_.Freeze();
+        auto is_unit = [&grammar](int rule) {
+            auto right = grammar.Right(rule);
+            return right.size() == 1 && !grammar.IsTerminal(right[0]);
+        };
+
+        // Rows of the table are contiguous, a state is a unit state if all its actions reduce the same unit rule.
+        std::map<int, int> unit_rules;
+        for (auto row = function_.begin(); row != function_.end();) {
+            int state = row->first.first;
+            auto action = row->second;
+            bool unit = action.first == 'r' && is_unit(action.second);
+            for (; row != function_.end() && row->first.first == state; ++row)
+                unit = unit && row->second == action;
+            if (unit)
+                unit_rules[state] = action.second;
+        }
+        if (unit_rules.empty())
+            return 0;
+
+        int redirected = 0;
+        for (auto &[key, action] : function_) {
+            if (action.first != 'g')
+                continue;
+            int target = action.second;
+            // Every step goes up a chain of unit rules, which can't be longer than the number of unit states.
+            for (std::size_t steps = 0; steps <= unit_rules.size() && unit_rules.count(target); ++steps) {
+                auto go_to = function_.find({key.first, grammar.Name(grammar.Left(unit_rules[target]))});
+                if (go_to == function_.end() || go_to->second.first != 'g')
+                    break;
+                target = go_to->second.second;
+            }
+            if (target != action.second) {
+                action.second = target;
+                ++redirected;
+            }
+        }
+
+        std::set<int> reached = {0};
+        for (const auto &[key, action] : function_) {
+            if (action.first == 's' || action.first == 'g')
+                reached.insert(action.second);
+        }
+        for (auto row = function_.begin(); row != function_.end();) {
+            if (unit_rules.count(row->first.first) && !reached.count(row->first.first))
+                row = function_.erase(row);
+            else
+                ++row;
+        }
+        return redirected;
+    }
+
+    bool LRParser::ResolveShiftReduce(const grammar::FrozenGrammar &grammar, int state,
+                                      grammar::FrozenGrammar::Symbol terminal, int next_state) {
+        using Associativity = grammar::Precedence::Associativity;
+        auto &action = function_[{state, grammar.Name(terminal)}];
+        const auto &shift = grammar.TerminalPrecedence(terminal);
+        const auto &reduce = grammar.RulePrecedence(action.second);
+        if (shift.level == 0 || reduce.level == 0)
+            return false;
+        if (shift.level > reduce.level || (shift.level == reduce.level && shift.associativity == Associativity::kRight))
+            action = {'s', next_state};
+        else if (shift.level == reduce.level && shift.associativity == Associativity::kNonAssoc)
+            function_.erase({state, grammar.Name(terminal)});
+        return true;
+    }
+
+    bool LRParser::ParseTree(SyntaxTree &tree) {
+        tree.Clear();
+        TreeActions actions = {tree, grammar_, {}};
+        SyntaxNode root;
+        if (!Translate(actions, root))
+            return false;
+        SyntaxNode *root_node = tree.NewNodes(1);
+        *root_node = root;
+        tree.set_root(root_node);
+        return true;
+    }
+} // namespace compiler::parsers
@@ -0,0 +1,46 @@
+#include "parsers/parser_algorithms/syntax_tree.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace compiler::parsers {
+
+    void *Arena::Allocate(std::size_t size, std::size_t alignment) {
+        std::size_t padding = (alignment - (std::size_t) next_ % alignment) % alignment;
+        if (!next_ || padding + size > available_) {
+            std::size_t block_size = std::max(kBlockSize, size + alignment);
+            blocks_.emplace_back(new char[block_size]);
+            next_ = blocks_.back().get();
+            available_ = block_size;
+            padding = (alignment - (std::size_t) next_ % alignment) % alignment;
+        }
+        void *result = next_ + padding;
+        next_ += padding + size;
+        available_ -= padding + size;
+        return result;
+    }
+
+    void Arena::Clear() {
+        blocks_.clear();
+        next_ = nullptr;
+        available_ = 0;
+    }
+
+    void SyntaxTree::Clear() {
+        arena_.Clear();
+        tokens_.clear();
+        root_ = nullptr;
+    }
+
+    std::string_view SyntaxTree::Intern(std::string_view symbol) {
+        auto it = symbols_.find(symbol);
+        if (it == symbols_.end())
+            it = symbols_.emplace(symbol).first;
+        return *it;
+    }
+
+    std::size_t SyntaxTree::AddToken(analyzers::Token token) {
+        tokens_.push_back(std::move(token));
+        return tokens_.size() - 1;
+    }
+} // namespace compiler::parsers
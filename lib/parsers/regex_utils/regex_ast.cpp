@@ -0,0 +1,208 @@
+#include "parsers/regex_utils/regex_ast.h"
+
+#include <map>
+#include <utility>
+
+namespace compiler::regex {
+
+    RegexNodePtr RegexNode::Empty() {
+        return std::make_shared<const RegexNode>(RegexNode{RegexNodeType::EMPTY, {}, {}, 2});
+    }
+
+    RegexNodePtr RegexNode::Class(std::set<char> bytes) {
+        return std::make_shared<const RegexNode>(RegexNode{RegexNodeType::CLASS, std::move(bytes), {}, 2});
+    }
+
+    RegexNodePtr RegexNode::Concat(std::vector<RegexNodePtr> children) {
+        std::size_t states = 0;
+        for (const auto &child : children)
+            states += child->states;
+        return std::make_shared<const RegexNode>(RegexNode{RegexNodeType::CONCAT, {}, std::move(children), states});
+    }
+
+    RegexNodePtr RegexNode::Union(std::vector<RegexNodePtr> children) {
+        std::size_t states = 1;
+        for (const auto &child : children)
+            states += child->states;
+        return std::make_shared<const RegexNode>(RegexNode{RegexNodeType::UNION, {}, std::move(children), states});
+    }
+
+    RegexNodePtr RegexNode::Closure(RegexNodeType type, RegexNodePtr child) {
+        std::size_t states = child->states + 2;
+        return std::make_shared<const RegexNode>(RegexNode{type, {}, {std::move(child)}, states});
+    }
+
+    bool Equal(const RegexNodePtr &a, const RegexNodePtr &b) {
+        if (a == b)
+            return true;
+        if (a->type != b->type || a->bytes != b->bytes || a->children.size() != b->children.size())
+            return false;
+        for (std::size_t i = 0; i < a->children.size(); ++i) {
+            if (!Equal(a->children[i], b->children[i]))
+                return false;
+        }
+        return true;
+    }
+
+    namespace {
+        bool isClosure(RegexNodeType type) {
+            return type == RegexNodeType::STAR || type == RegexNodeType::PLUS || type == RegexNodeType::OPTIONAL;
+        }
+
+        /*!
+         * @brief Simplifies a tree, visiting every shared subtree only once.
+         */
+        class Simplifier {
+            std::map<const RegexNode *, RegexNodePtr> simplified_;
+
+            RegexNodePtr SimplifyConcat(const std::vector<RegexNodePtr> &children) {
+                std::vector<RegexNodePtr> factors;
+                for (const auto &child : children) {
+                    if (child->type == RegexNodeType::CONCAT)
+                        factors.insert(factors.end(), child->children.begin(), child->children.end());
+                    else if (child->type != RegexNodeType::EMPTY)
+                        factors.push_back(child);
+                }
+                // x x* = x+
+                for (std::size_t i = 0; i + 1 < factors.size(); ++i) {
+                    if (factors[i + 1]->type == RegexNodeType::STAR && Equal(factors[i], factors[i + 1]->children[0])) {
+                        factors[i] = RegexNode::Closure(RegexNodeType::PLUS, factors[i]);
+                        factors.erase(factors.begin() + (long) i + 1);
+                    }
+                }
+                if (factors.empty())
+                    return RegexNode::Empty();
+                if (factors.size() == 1)
+                    return factors[0];
+                return RegexNode::Concat(factors);
+            }
+
+            RegexNodePtr SimplifyUnion(const std::vector<RegexNodePtr> &children) {
+                std::vector<RegexNodePtr> alternatives;
+                for (const auto &child : children) {
+                    if (child->type == RegexNodeType::UNION)
+                        alternatives.insert(alternatives.end(), child->children.begin(), child->children.end());
+                    else
+                        alternatives.push_back(child);
+                }
+
+                // Groups the alternatives by their first factor, keeping the order of the first appearance.
+                std::vector<std::pair<RegexNodePtr, std::vector<RegexNodePtr>>> groups;
+                for (const auto &alternative : alternatives) {
+                    RegexNodePtr head = alternative;
+                    RegexNodePtr tail = RegexNode::Empty();
+                    if (alternative->type == RegexNodeType::CONCAT) {
+                        head = alternative->children[0];
+                        tail = SimplifyConcat({alternative->children.begin() + 1, alternative->children.end()});
+                    }
+                    auto group = groups.begin();
+                    while (group != groups.end() && !Equal(group->first, head))
+                        ++group;
+                    if (group == groups.end())
+                        groups.emplace_back(head, std::vector<RegexNodePtr>{tail});
+                    else
+                        group->second.push_back(tail);
+                }
+
+                bool optional = false, has_class = false;
+                std::set<char> bytes;
+                std::vector<RegexNodePtr> result;
+                for (const auto &[head, tails] : groups) {
+                    RegexNodePtr alternative = SimplifyConcat({head, tails.size() == 1 ? tails[0] : SimplifyUnion(tails)});
+
+                    if (alternative->type == RegexNodeType::EMPTY) {
+                        optional = true;
+                    } else if (alternative->type == RegexNodeType::CLASS) {
+                        if (!has_class)
+                            result.push_back(nullptr); // Place of the merged class.
+                        has_class = true;
+                        bytes.insert(alternative->bytes.begin(), alternative->bytes.end());
+                    } else {
+                        result.push_back(alternative);
+                    }
+                }
+                for (auto &alternative : result) {
+                    if (!alternative)
+                        alternative = RegexNode::Class(bytes);
+                }
+
+                if (result.empty())
+                    return RegexNode::Empty();
+                RegexNodePtr node = result.size() == 1 ? result[0] : RegexNode::Union(result);
+                return optional ? SimplifyClosure(RegexNodeType::OPTIONAL, node) : node;
+            }
+
+            static RegexNodePtr SimplifyClosure(RegexNodeType type, const RegexNodePtr &child) {
+                if (child->type == RegexNodeType::EMPTY)
+                    return child;
+                if (!isClosure(child->type))
+                    return RegexNode::Closure(type, child);
+                // Two nested closures are the closure itself if both are equal, otherwise a star.
+                if (child->type == type)
+                    return child;
+                return RegexNode::Closure(RegexNodeType::STAR, child->children[0]);
+            }
+
+        public:
+            RegexNodePtr Simplify(const RegexNodePtr &node) {
+                auto saved = simplified_.find(node.get());
+                if (saved != simplified_.end())
+                    return saved->second;
+
+                std::vector<RegexNodePtr> children;
+                for (const auto &child : node->children)
+                    children.push_back(Simplify(child));
+
+                RegexNodePtr result;
+                switch (node->type) {
+                    case RegexNodeType::EMPTY:
+                    case RegexNodeType::CLASS:
+                        result = node;
+                        break;
+                    case RegexNodeType::CONCAT:
+                        result = SimplifyConcat(children);
+                        break;
+                    case RegexNodeType::UNION:
+                        result = SimplifyUnion(children);
+                        break;
+                    default:
+                        result = SimplifyClosure(node->type, children[0]);
+                        break;
+                }
+                simplified_[node.get()] = result;
+                return result;
+            }
+        };
+    }
+
+    RegexNodePtr Simplify(const RegexNodePtr &node) {
+        return Simplifier().Simplify(node);
+    }
+
+    automata::NFA BuildNFA(const RegexNodePtr &node) {
+        switch (node->type) {
+            case RegexNodeType::EMPTY:
+                return automata::NFA::CreateSimpleNFA('\0');
+            case RegexNodeType::CLASS:
+                return automata::NFA::CreateSimpleNFA(node->bytes);
+            case RegexNodeType::CONCAT: {
+                automata::NFA result = BuildNFA(node->children[0]);
+                for (std::size_t i = 1; i < node->children.size(); ++i)
+                    result = result.Concatenation(BuildNFA(node->children[i]));
+                return result;
+            }
+            case RegexNodeType::UNION: {
+                std::vector<automata::NFA> alternatives;
+                for (const auto &child : node->children)
+                    alternatives.push_back(BuildNFA(child));
+                return automata::NFA::CalculateLexicalUnion(alternatives);
+            }
+            case RegexNodeType::STAR:
+                return BuildNFA(node->children[0]).KleeneClosure();
+            case RegexNodeType::PLUS:
+                return BuildNFA(node->children[0]).PlusClosure();
+            default:
+                return BuildNFA(node->children[0]).Optional();
+        }
+    }
+} //namespace compiler::regex
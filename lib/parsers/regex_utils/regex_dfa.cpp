@@ -0,0 +1,157 @@
+#include "parsers/regex_utils/regex_dfa.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <set>
+
+namespace compiler::regex {
+
+    namespace {
+        using Positions = std::vector<int>; //!< Sorted set of positions.
+
+        void Merge(Positions &to, const Positions &from) {
+            Positions merged;
+            std::set_union(to.begin(), to.end(), from.begin(), from.end(), std::back_inserter(merged));
+            to.swap(merged);
+        }
+
+        /*!
+         * @brief Positions and followpos sets of the trees of a specification.
+         */
+        struct PositionBuilder {
+            struct Info {
+                bool nullable;
+                Positions first;
+                Positions last;
+            };
+
+            std::vector<const std::set<char> *> bytes;  //!< Bytes of every position, nullptr for end markers.
+            std::vector<int> rules;                     //!< Rule of every end marker, -1 for byte positions.
+            std::vector<Positions> follow;
+
+            int NewPosition(const std::set<char> *position_bytes, int rule) {
+                bytes.push_back(position_bytes);
+                rules.push_back(rule);
+                follow.emplace_back();
+                return (int) bytes.size() - 1;
+            }
+
+            void AddFollow(const Positions &from, const Positions &to) {
+                for (int position : from)
+                    Merge(follow[position], to);
+            }
+
+            // A shared subtree is visited once per occurrence, every occurrence has its own positions.
+            Info Visit(const RegexNodePtr &node) {
+                switch (node->type) {
+                    case RegexNodeType::EMPTY:
+                        return {true, {}, {}};
+                    case RegexNodeType::CLASS: {
+                        int position = NewPosition(&node->bytes, -1);
+                        return {false, {position}, {position}};
+                    }
+                    case RegexNodeType::CONCAT: {
+                        Info info = Visit(node->children[0]);
+                        for (std::size_t i = 1; i < node->children.size(); ++i) {
+                            Info next = Visit(node->children[i]);
+                            AddFollow(info.last, next.first);
+                            if (info.nullable)
+                                Merge(info.first, next.first);
+                            if (next.nullable)
+                                Merge(info.last, next.last);
+                            else
+                                info.last = next.last;
+                            info.nullable = info.nullable && next.nullable;
+                        }
+                        return info;
+                    }
+                    case RegexNodeType::UNION: {
+                        Info info = {false, {}, {}};
+                        for (const auto &child : node->children) {
+                            Info next = Visit(child);
+                            info.nullable = info.nullable || next.nullable;
+                            Merge(info.first, next.first);
+                            Merge(info.last, next.last);
+                        }
+                        return info;
+                    }
+                    case RegexNodeType::STAR:
+                    case RegexNodeType::PLUS: {
+                        Info info = Visit(node->children[0]);
+                        AddFollow(info.last, info.first);
+                        info.nullable = info.nullable || node->type == RegexNodeType::STAR;
+                        return info;
+                    }
+                    default: {
+                        Info info = Visit(node->children[0]);
+                        info.nullable = true;
+                        return info;
+                    }
+                }
+            }
+        };
+    }
+
+    automata::DFA BuildDFA(const std::vector<RegexRule> &rules) {
+        PositionBuilder builder;
+        Positions initial;
+        for (std::size_t rule = 0; rule < rules.size(); ++rule) {
+            PositionBuilder::Info info = builder.Visit(rules[rule].regex);
+            Positions end = {builder.NewPosition(nullptr, (int) rule)};
+            builder.AddFollow(info.last, end);
+            Merge(initial, info.first);
+            if (info.nullable)
+                Merge(initial, end);
+        }
+
+        std::set<char> alphabet;
+        for (const auto *bytes : builder.bytes) {
+            if (bytes)
+                alphabet.insert(bytes->begin(), bytes->end());
+        }
+
+        std::map<Positions, int> states = {{initial, 1}};
+        std::vector<const Positions *> pending = {&states.begin()->first};
+        std::map<std::pair<int, char>, int> transitions;
+        std::set<int> accepting_states;
+        std::map<int, std::string> tokens;
+        std::map<int, int> rule_ids;
+        std::map<char, Positions> next_states;
+        for (std::size_t i = 0; i < pending.size(); ++i) {
+            int state = (int) i + 1;
+            const Positions &positions = *pending[i];
+
+            next_states.clear();
+            int rule = -1;
+            for (int position : positions) {
+                if (!builder.bytes[position]) {
+                    rule = std::max(rule, builder.rules[position]);
+                    continue;
+                }
+                for (char c : *builder.bytes[position])
+                    Merge(next_states[c], builder.follow[position]);
+            }
+            if (rule != -1) {
+                accepting_states.insert(state);
+                rule_ids[state] = rule;
+                if (!rules[rule].action.empty())
+                    tokens[state] = rules[rule].action;
+            }
+
+            for (char c : alphabet) {
+                auto next = next_states.find(c);
+                if (next == next_states.end()) {
+                    transitions[std::make_pair(state, c)] = -1;
+                    continue;
+                }
+                auto saved = states.emplace(next->second, (int) states.size() + 1);
+                if (saved.second)
+                    pending.push_back(&saved.first->first);
+                transitions[std::make_pair(state, c)] = saved.first->second;
+            }
+        }
+
+        return automata::DFA((int) states.size(), alphabet, transitions, 1, accepting_states, tokens, rule_ids);
+    }
+} //namespace compiler::regex
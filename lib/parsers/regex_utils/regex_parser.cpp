@@ -1,67 +1,227 @@
 #include "parsers/regex_utils/regex_parser.h"
 
+#include <algorithm>
+#include <cctype>
 #include <set>
 #include <string>
 
 namespace compiler::regex {
 
+    const std::string RegexParser::kInitialMode = "INITIAL";
+
+    const std::vector<RegexRule> &RegexParser::ParseRules() {
+        if (!parsed_) {
+            Machine();
+            parsed_ = true;
+        }
+        return rules_;
+    }
+
+    std::map<std::string, std::vector<automata::NFA>> RegexParser::ParseModes() {
+        std::map<std::string, std::vector<automata::NFA>> mode_rules;
+        ParseRules();
+        for (const auto &mode : modes_)
+            mode_rules[mode];
+        for (std::size_t i = 0; i < rules_.size(); ++i) {
+            const RegexRule &rule = rules_[i];
+            automata::NFA automata = BuildNFA(rule.regex);
+            automata.AddAcceptingValue(rule.action, (int) i);
+            if (rule.modes.empty()) {
+                for (auto &mode : mode_rules)
+                    mode.second.push_back(automata);
+            } else {
+                for (const auto &mode : rule.modes)
+                    mode_rules[mode].push_back(automata);
+            }
+        }
+        return mode_rules;
+    }
+
     void RegexParser::Machine() {
         regex_scanner_.GetNextToken();
-        lexical_nfa_.push_back(Rule());
+        if (HasDefinitions())
+            Definitions();
+        rules_.push_back(Rule());
         while (regex_scanner_.current_token() != TokenCodeRegex::END_OF_INPUT && regex_scanner_.current_token() != TokenCodeRegex::EOS) {
-            lexical_nfa_.push_back(Rule());
+            rules_.push_back(Rule());
         }
     }
 
-    automata::NFA RegexParser::Rule() {
-        automata::NFA new_automata;
+    bool RegexParser::IsName(const std::string &text) {
+        if (text.empty() || isdigit((unsigned char) text.front()))
+            return false;
+        return std::all_of(text.begin(), text.end(), [](char c) { return isalnum((unsigned char) c) || c == '_'; });
+    }
 
-        if (regex_scanner_.current_token() == TokenCodeRegex::AT_BOL) {
+    bool RegexParser::HasDefinitions() {
+        // "NAME regex" and "regex TOKEN" lines look the same until the %% line, so lines are read ahead while
+        // they start with a name, and given back to the scanner once the section is found or ruled out.
+        std::vector<RegexToken> tokens;
+        auto field = [this, &tokens]() {
+            std::string text;
+            while (regex_scanner_.current_token() == TokenCodeRegex::EOS) {
+                tokens.push_back(regex_scanner_.current_token());
+                regex_scanner_.GetNextToken();
+            }
+            while (regex_scanner_.current_token() != TokenCodeRegex::EOS &&
+                   regex_scanner_.current_token() != TokenCodeRegex::END_OF_INPUT) {
+                text += regex_scanner_.current_token().lexeme;
+                tokens.push_back(regex_scanner_.current_token());
+                regex_scanner_.GetNextToken();
+            }
+            return text;
+        };
+
+        bool found = false;
+        while (regex_scanner_.current_token() != TokenCodeRegex::END_OF_INPUT) {
+            std::string name = field();
+            if (name == "%%") {
+                found = true;
+                break;
+            }
+            if (!IsName(name) || regex_scanner_.current_token() == TokenCodeRegex::END_OF_INPUT)
+                break;
+            tokens.push_back(regex_scanner_.current_token());
             regex_scanner_.GetNextToken();
-            new_automata = automata::NFA::CreateSimpleNFA('\n');
-            Expr(new_automata);
-        } else {
-            Expr(new_automata);
+            field();
+        }
+        tokens.push_back(regex_scanner_.current_token());
+        regex_scanner_.PutBack(tokens);
+        return found;
+    }
+
+    void RegexParser::Definitions() {
+        while (true) {
+            while (regex_scanner_.current_token() == TokenCodeRegex::EOS)
+                regex_scanner_.GetNextToken();
+            if (regex_scanner_.current_token() == TokenCodeRegex::END_OF_INPUT)
+                SyntaxError(error::BadDefinition);
+            if (regex_scanner_.current_token().lexeme == '%') {
+                if (regex_scanner_.GetNextToken().lexeme != '%' || regex_scanner_.GetNextToken() != TokenCodeRegex::EOS)
+                    SyntaxError(error::BadDefinition);
+                break;
+            }
+
+            std::string name;
+            while (regex_scanner_.current_token() != TokenCodeRegex::EOS) {
+                name += regex_scanner_.current_token().lexeme;
+                regex_scanner_.GetNextToken();
+            }
+            if (!IsName(name))
+                SyntaxError(error::BadDefinition);
+
+            regex_scanner_.GetNextToken();
+            RegexNodePtr definition = Expr();
+            if (regex_scanner_.current_token() != TokenCodeRegex::EOS)
+                SyntaxError(error::BadDefinition);
+            definitions_[name] = definition;
         }
+        while (regex_scanner_.current_token() == TokenCodeRegex::EOS)
+            regex_scanner_.GetNextToken();
+    }
 
-        if (regex_scanner_.current_token() == TokenCodeRegex::AT_EOL) {
+    RegexRule RegexParser::Rule() {
+        RegexRule rule;
+
+        rule.modes = {kInitialMode};
+        if (regex_scanner_.current_token() == TokenCodeRegex::OPEN_ANGLE && IsStartConditions()) {
             regex_scanner_.GetNextToken();
-            std::set<char> labels;
-            labels.insert('\n');
-            labels.insert('\r');
-            new_automata.Concatenation(automata::NFA::CreateSimpleNFA(labels));
+            StartConditions(rule.modes);
         }
 
+        // Tokens never contain a newline (the analyzers stop at whitespace), so the anchors ^ and $ are accepted
+        // but add nothing to the expression.
+        if (regex_scanner_.current_token() == TokenCodeRegex::AT_BOL)
+            regex_scanner_.GetNextToken();
+        rule.regex = Simplify(Expr());
+        if (regex_scanner_.current_token() == TokenCodeRegex::AT_EOL)
+            regex_scanner_.GetNextToken();
+
         regex_scanner_.GetNextToken();
-        std::string action;
         while (regex_scanner_.current_token() != TokenCodeRegex::EOS) {
-            action += regex_scanner_.current_token().lexeme;
+            rule.action += regex_scanner_.current_token().lexeme;
             regex_scanner_.GetNextToken();
         }
-        new_automata.AddAcceptingValue(action);
         regex_scanner_.GetNextToken();
-        return new_automata;
+        return rule;
     }
 
-    void RegexParser::Expr(automata::NFA &automata) {
-        automata::NFA new_automata;
-        CatExpr(automata);
-        while (regex_scanner_.current_token() == TokenCodeRegex::OR) {
-            regex_scanner_.GetNextToken();
-            CatExpr(new_automata);
-            automata = automata.Union(new_automata);
+    bool RegexParser::IsStartConditions() {
+        std::vector<RegexToken> tokens = {regex_scanner_.current_token()};
+        std::string list;
+        while (regex_scanner_.GetNextToken() == TokenCodeRegex::L ||
+               regex_scanner_.current_token() == TokenCodeRegex::CLOSURE) {
+            list += regex_scanner_.current_token().lexeme;
+            tokens.push_back(regex_scanner_.current_token());
+        }
+        bool conditions = regex_scanner_.current_token() == TokenCodeRegex::CLOSE_ANGLE;
+        tokens.push_back(regex_scanner_.current_token());
+        if (conditions) {
+            // The list must be followed by the expression of the rule, "<a>  TAG" matches the text <a>.
+            tokens.push_back(regex_scanner_.GetNextToken());
+            conditions = regex_scanner_.current_token() != TokenCodeRegex::EOS &&
+                         regex_scanner_.current_token() != TokenCodeRegex::END_OF_INPUT;
+        }
+        regex_scanner_.PutBack(tokens);
+
+        std::size_t begin = 0;
+        while (conditions) {
+            std::size_t end = std::min(list.find(',', begin), list.size());
+            std::string name = list.substr(begin, end - begin);
+            conditions = name == "*" || IsName(name);
+            if (end == list.size())
+                break;
+            begin = end + 1;
         }
+        return conditions;
     }
 
-    void RegexParser::CatExpr(automata::NFA &automata) {
-        automata::NFA new_automata;
+    void RegexParser::StartConditions(std::set<std::string> &modes) {
+        modes.clear();
+        bool every_mode = false;
+        std::string name;
+        while (regex_scanner_.current_token() != TokenCodeRegex::CLOSE_ANGLE) {
+            if (regex_scanner_.current_token() == TokenCodeRegex::EOS ||
+                regex_scanner_.current_token() == TokenCodeRegex::END_OF_INPUT)
+                SyntaxError(error::BadStartCondition);
+            if (regex_scanner_.current_token() == TokenCodeRegex::CLOSURE) {
+                every_mode = true;
+            } else if (regex_scanner_.current_token().lexeme == ',') {
+                if (name.empty())
+                    SyntaxError(error::BadStartCondition);
+                modes.insert(name);
+                name.clear();
+            } else {
+                name += regex_scanner_.current_token().lexeme;
+            }
+            regex_scanner_.GetNextToken();
+        }
+        regex_scanner_.GetNextToken();
+        if (!name.empty())
+            modes.insert(name);
+        if (every_mode)
+            modes.clear();
+        else if (modes.empty())
+            SyntaxError(error::BadStartCondition);
+        modes_.insert(modes.begin(), modes.end());
+    }
 
-        if (isConcatenable(regex_scanner_.current_token()))
-            Factor(automata);
-        while (isConcatenable(regex_scanner_.current_token())) {
-            Factor(new_automata);
-            automata = automata.Concatenation(new_automata);
+    RegexNodePtr RegexParser::Expr() {
+        std::vector<RegexNodePtr> alternatives = {CatExpr()};
+        while (regex_scanner_.current_token() == TokenCodeRegex::OR) {
+            regex_scanner_.GetNextToken();
+            alternatives.push_back(CatExpr());
         }
+        return alternatives.size() == 1 ? alternatives[0] : RegexNode::Union(alternatives);
+    }
+
+    RegexNodePtr RegexParser::CatExpr() {
+        std::vector<RegexNodePtr> factors;
+        while (isConcatenable(regex_scanner_.current_token()))
+            factors.push_back(Factor());
+        if (factors.empty())
+            return RegexNode::Empty();
+        return factors.size() == 1 ? factors[0] : RegexNode::Concat(factors);
     }
 
     bool RegexParser::isConcatenable(RegexToken input_char) {
@@ -88,76 +248,174 @@ namespace compiler::regex {
 
     }
 
-    void RegexParser::Factor(automata::NFA &automata) {
-        Term(automata);
+    RegexNodePtr RegexParser::Factor() {
+        RegexNodePtr node = Term();
         if (regex_scanner_.current_token() == TokenCodeRegex::CLOSURE) {
-            automata = automata.KleeneClosure();
+            node = RegexNode::Closure(RegexNodeType::STAR, node);
             regex_scanner_.GetNextToken();
         } else if (regex_scanner_.current_token() == TokenCodeRegex::PLUS_CLOSURE) {
-            automata = automata.PlusClosure();
+            node = RegexNode::Closure(RegexNodeType::PLUS, node);
             regex_scanner_.GetNextToken();
         } else if (regex_scanner_.current_token() == TokenCodeRegex::OPTIONAL) {
-            automata = automata.Optional();
+            node = RegexNode::Closure(RegexNodeType::OPTIONAL, node);
+            regex_scanner_.GetNextToken();
+        } else if (regex_scanner_.current_token() == TokenCodeRegex::OPEN_CURLY) {
+            // {m,n} repeats this factor, any other { starts the next one.
+            RegexToken open = regex_scanner_.current_token();
+            RegexToken next = regex_scanner_.GetNextToken();
+            if (next == TokenCodeRegex::L && isdigit((unsigned char) next.lexeme))
+                node = Repetition(node);
+            else
+                regex_scanner_.PutBack({open, next});
+        }
+        return node;
+    }
+
+    int RegexParser::Count() {
+        int count = -1;
+        while (regex_scanner_.current_token() == TokenCodeRegex::L &&
+               isdigit((unsigned char) regex_scanner_.current_token().lexeme)) {
+            count = std::max(count, 0) * 10 + (regex_scanner_.current_token().lexeme - '0');
+            if ((std::size_t) count > kMaxRepetitionStates)
+                SyntaxError(error::RepetitionTooLarge);
             regex_scanner_.GetNextToken();
         }
+        return count;
     }
 
-    void RegexParser::Term(automata::NFA &automata) {
+    RegexNodePtr RegexParser::Repetition(const RegexNodePtr &node) {
+        int min = Count();
+        int max = min;
+        if (regex_scanner_.current_token() == TokenCodeRegex::L && regex_scanner_.current_token().lexeme == ',') {
+            regex_scanner_.GetNextToken();
+            max = Count();
+        }
+        if (min == -1 || regex_scanner_.current_token() != TokenCodeRegex::CLOSE_CURLY || (max != -1 && max < min))
+            SyntaxError(error::BadRepetition);
+        regex_scanner_.GetNextToken();
+
+        // Every copy below shares the subtree parsed once by Term(), BuildNFA() gives each one its own states.
+        std::size_t copies = max == -1 ? min + 1 : max;
+        if (copies * node->states > kMaxRepetitionStates)
+            SyntaxError(error::RepetitionTooLarge);
+
+        // The optional part is nested, x{2,4} = xx(x(x)?)?, so every optional copy is entered from one place.
+        std::vector<RegexNodePtr> factors(min, node);
+        if (max == -1) {
+            factors.push_back(RegexNode::Closure(RegexNodeType::STAR, node));
+        } else if (max != min) {
+            RegexNodePtr tail = RegexNode::Closure(RegexNodeType::OPTIONAL, node);
+            for (int i = min + 1; i < max; ++i)
+                tail = RegexNode::Closure(RegexNodeType::OPTIONAL, RegexNode::Concat({node, tail}));
+            factors.push_back(tail);
+        }
+        if (factors.empty())
+            return RegexNode::Empty();
+        return factors.size() == 1 ? factors[0] : RegexNode::Concat(factors);
+    }
+
+    RegexNodePtr RegexParser::Term() {
+        RegexNodePtr node;
         bool complement = false;
         if (regex_scanner_.current_token() == TokenCodeRegex::OPEN_PAREN) {
             regex_scanner_.GetNextToken();
-            Expr(automata);
+            node = Expr();
             if (regex_scanner_.current_token() == TokenCodeRegex::CLOSE_PAREN)
                 regex_scanner_.GetNextToken();
             else
                 SyntaxError(error::MissingCloseParenthesis);
+        } else if (regex_scanner_.current_token() == TokenCodeRegex::OPEN_CURLY && IsExpansion()) {
+            node = Expansion();
         } else {
             if (regex_scanner_.current_token() != TokenCodeRegex::ANY && regex_scanner_.current_token() != TokenCodeRegex::CCL_START) {
-                automata = automata::NFA::CreateSimpleNFA(regex_scanner_.current_token().lexeme);
+                node = RegexNode::Class({regex_scanner_.current_token().lexeme});
                 regex_scanner_.GetNextToken();
             } else {
                 if (regex_scanner_.current_token() == TokenCodeRegex::ANY) {
-                    automata = automata::NFA::CreateSimpleNFA(any_char_);
+                    node = CreateClass(any_char_);
                 } else {
-                    std::set<char> cs;
+                    std::vector<CodePointRange> ranges;
                     if (regex_scanner_.GetNextToken() == TokenCodeRegex::AT_BOL) {
                         regex_scanner_.GetNextToken();
                         complement = true;
                     }
-                    if (regex_scanner_.current_token() != TokenCodeRegex::CCL_END) {
-                        Dash(cs);
-                    } else {
-                        for (int c = 0; c <= ' '; c++)
-                            cs.insert(c);
-                    }
-                    if (complement) {
-                        std::set<char> ccs;
-                        for (int i = 0; i <= 127; i++) {
-                            if (!cs.count((char) i))
-                                ccs.insert((char) i);
-                        }
-                        automata = automata::NFA::CreateSimpleNFA(ccs);
-                    } else {
-                        automata = automata::NFA::CreateSimpleNFA(cs);
-                    }
+                    if (regex_scanner_.current_token() != TokenCodeRegex::CCL_END)
+                        Dash(ranges);
+                    else
+                        ranges.emplace_back(1, ' ');
+                    if (complement)
+                        ranges = ComplementRanges(ranges, max_char());
+                    node = CreateClass(ranges);
                 }
                 regex_scanner_.GetNextToken();
             }
         }
+        return node;
+    }
+
+    bool RegexParser::IsExpansion() {
+        if (definitions_.empty())
+            return false;
+        std::vector<RegexToken> tokens = {regex_scanner_.current_token()};
+        std::string name;
+        while (regex_scanner_.GetNextToken() == TokenCodeRegex::L) {
+            name += regex_scanner_.current_token().lexeme;
+            tokens.push_back(regex_scanner_.current_token());
+        }
+        bool expansion = IsName(name) && regex_scanner_.current_token() == TokenCodeRegex::CLOSE_CURLY;
+        tokens.push_back(regex_scanner_.current_token());
+        regex_scanner_.PutBack(tokens);
+        return expansion;
     }
 
-    void RegexParser::Dash(std::set<char> &automata) {
-        char lastLexeme = 0;
+    RegexNodePtr RegexParser::Expansion() {
+        std::string name;
+        while (regex_scanner_.GetNextToken() != TokenCodeRegex::CLOSE_CURLY)
+            name += regex_scanner_.current_token().lexeme;
+        auto definition = definitions_.find(name);
+        if (definition == definitions_.end())
+            SyntaxError(error::MissingMacro);
+        regex_scanner_.GetNextToken();
+        return definition->second;
+    }
+
+    void RegexParser::Dash(std::vector<CodePointRange> &ranges) {
+        char32_t last_char = 0;
         for (; regex_scanner_.current_token() != TokenCodeRegex::EOS &&
                regex_scanner_.current_token() != TokenCodeRegex::CCL_END; regex_scanner_.GetNextToken()) {
             if (regex_scanner_.current_token() != TokenCodeRegex::DASH) {
-                lastLexeme = regex_scanner_.current_token().lexeme;
-                automata.insert(lastLexeme);
+                last_char = ReadChar();
+                ranges.emplace_back(last_char, last_char);
             } else {
                 regex_scanner_.GetNextToken();
-                for (; lastLexeme <= regex_scanner_.current_token().lexeme; ++lastLexeme)
-                    automata.insert(lastLexeme);
+                ranges.emplace_back(last_char, ReadChar());
             }
         }
     }
+
+    char32_t RegexParser::ReadChar() {
+        auto lead = (unsigned char) regex_scanner_.current_token().lexeme;
+        if (encoding_ == Encoding::BYTES || lead <= 0x7F)
+            return lead;
+
+        int length = Utf8SequenceLength(lead);
+        if (length == 0)
+            SyntaxError(error::InvalidUtf8);
+        char32_t code_point = lead & (0x7F >> length);
+        for (int i = 1; i < length; ++i) {
+            auto byte = (unsigned char) regex_scanner_.GetNextToken().lexeme;
+            if ((byte & 0xC0) != 0x80)
+                SyntaxError(error::InvalidUtf8);
+            code_point = (code_point << 6) | (byte & 0x3F);
+        }
+        static const char32_t kMinCodePoint[] = {0, 0, 0x80, 0x800, 0x10000};
+        if (code_point < kMinCodePoint[length] || code_point > kMaxCodePoint ||
+            (code_point >= 0xD800 && code_point <= 0xDFFF))
+            SyntaxError(error::InvalidUtf8);
+        return code_point;
+    }
+
+    RegexNodePtr RegexParser::CreateClass(const std::vector<CodePointRange> &ranges) const {
+        return encoding_ == Encoding::UTF8 ? CreateUtf8Class(ranges) : CreateByteClass(ranges);
+    }
 } //namespace compiler::regex
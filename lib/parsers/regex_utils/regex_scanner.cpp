@@ -19,6 +19,8 @@ namespace compiler::regex {
         char_code_map_['-'] = TokenCodeRegex::DASH;
         char_code_map_['.'] = TokenCodeRegex::ANY;
         for (i = '/'; i <= '>'; i++) char_code_map_[i] = TokenCodeRegex::L;
+        char_code_map_['<'] = TokenCodeRegex::OPEN_ANGLE;
+        char_code_map_['>'] = TokenCodeRegex::CLOSE_ANGLE;
         char_code_map_['?'] = TokenCodeRegex::OPTIONAL;
         for (i = '@'; i <= 'Z'; i++) char_code_map_[i] = TokenCodeRegex::L;
         char_code_map_['['] = TokenCodeRegex::CCL_START;
@@ -32,17 +34,24 @@ namespace compiler::regex {
         char_code_map_[';'] = TokenCodeRegex::SEMICOLON;
         char_code_map_[':'] = TokenCodeRegex::COLON;
         char_code_map_[127] = TokenCodeRegex::TOKEN_ERROR;
+        for (i = 128; i <= 255; i++) char_code_map_[i] = TokenCodeRegex::L;
     }
 
     void RegexScanner::SkipWhiteSpace() {
         char c = source_buffer_->GetChar();
-        while (isspace(c) && c != io_buffer::EOF_char)
+        while (isspace((unsigned char) c) && c != io_buffer::EOF_char)
             c = source_buffer_->FetchChar();
     }
 
     RegexToken RegexScanner::GetNextToken() {
         char lexeme;
 
+        if (!put_back_.empty()) {
+            current_token_ = put_back_.front();
+            put_back_.pop_front();
+            return current_token_;
+        }
+
         if (current_token_ == TokenCodeRegex::EOS) {
             if (in_quote_) SyntaxError(error::InvalidNewLine);
             SkipWhiteSpace();
@@ -72,7 +81,7 @@ namespace compiler::regex {
             SyntaxError(error::InvalidNewLine);
 
         if (!in_quote_) {
-            if (isspace(source_buffer_->GetChar())) {
+            if (isspace((unsigned char) source_buffer_->GetChar())) {
                 current_token_ = {TokenCodeRegex::EOS, '\0'};
                 return current_token_;
             }
@@ -80,8 +89,8 @@ namespace compiler::regex {
         } else {
             lexeme = source_buffer_->GetChar();
         }
-        TokenCodeRegex newToken = (in_quote_ || escape_) ? TokenCodeRegex::L : char_code_map_[lexeme];
-        if ((!in_quote_ || !escape_) && isspace(source_buffer_->GetChar())) {
+        TokenCodeRegex newToken = (in_quote_ || escape_) ? TokenCodeRegex::L : char_code_map_[(unsigned char) lexeme];
+        if ((!in_quote_ || !escape_) && isspace((unsigned char) source_buffer_->GetChar())) {
             SkipWhiteSpace();
             return GetNextToken();
         }
@@ -89,4 +98,8 @@ namespace compiler::regex {
         source_buffer_->FetchChar();
         return current_token_;
     }
+    void RegexScanner::PutBack(const std::vector<RegexToken> &tokens) {
+        put_back_.insert(put_back_.begin(), tokens.begin() + 1, tokens.end());
+        current_token_ = tokens.front();
+    }
 }// namespace compiler::parsers::regex
@@ -0,0 +1,166 @@
+#include "parsers/regex_utils/utf8.h"
+
+#include <algorithm>
+#include <set>
+
+namespace compiler::regex {
+
+    namespace {
+        using ByteSequence = std::vector<std::pair<unsigned char, unsigned char>>;
+
+        const char32_t kSurrogateBegin = 0xD800;
+        const char32_t kSurrogateEnd = 0xDFFF;
+
+        int Encode(char32_t code_point, unsigned char *bytes) {
+            if (code_point <= 0x7F) {
+                bytes[0] = code_point;
+                return 1;
+            }
+            if (code_point <= 0x7FF) {
+                bytes[0] = 0xC0 | (code_point >> 6);
+                bytes[1] = 0x80 | (code_point & 0x3F);
+                return 2;
+            }
+            if (code_point <= 0xFFFF) {
+                bytes[0] = 0xE0 | (code_point >> 12);
+                bytes[1] = 0x80 | ((code_point >> 6) & 0x3F);
+                bytes[2] = 0x80 | (code_point & 0x3F);
+                return 3;
+            }
+            bytes[0] = 0xF0 | (code_point >> 18);
+            bytes[1] = 0x80 | ((code_point >> 12) & 0x3F);
+            bytes[2] = 0x80 | ((code_point >> 6) & 0x3F);
+            bytes[3] = 0x80 | (code_point & 0x3F);
+            return 4;
+        }
+
+        void SplitRange(char32_t from, char32_t to, std::vector<ByteSequence> &sequences) {
+            // Both ends must have the same encoded length.
+            for (char32_t limit : {0x7Fu, 0x7FFu, 0xFFFFu}) {
+                if (from <= limit && limit < to) {
+                    SplitRange(from, limit, sequences);
+                    SplitRange(limit + 1, to, sequences);
+                    return;
+                }
+            }
+            // Every continuation byte but the first different one must cover its whole range 80-BF.
+            unsigned char from_bytes[4], to_bytes[4];
+            int length = Encode(from, from_bytes);
+            Encode(to, to_bytes);
+            for (int i = 1; i < length; ++i) {
+                char32_t mask = (1u << (6 * i)) - 1;
+                if ((from & ~mask) == (to & ~mask))
+                    continue;
+                if ((from & mask) != 0) {
+                    SplitRange(from, from | mask, sequences);
+                    SplitRange((from | mask) + 1, to, sequences);
+                    return;
+                }
+                if ((to & mask) != mask) {
+                    SplitRange(from, (to & ~mask) - 1, sequences);
+                    SplitRange(to & ~mask, to, sequences);
+                    return;
+                }
+            }
+            ByteSequence sequence;
+            for (int i = 0; i < length; ++i)
+                sequence.emplace_back(from_bytes[i], to_bytes[i]);
+            sequences.push_back(sequence);
+        }
+
+        RegexNodePtr CreateByteRange(unsigned char from, unsigned char to) {
+            std::set<char> bytes;
+            for (int c = from; c <= to; ++c)
+                bytes.insert((char) c);
+            return RegexNode::Class(bytes);
+        }
+    }
+
+    int Utf8SequenceLength(unsigned char lead) {
+        if (lead <= 0x7F)
+            return 1;
+        if (lead >= 0xC2 && lead <= 0xDF)
+            return 2;
+        if (lead >= 0xE0 && lead <= 0xEF)
+            return 3;
+        if (lead >= 0xF0 && lead <= 0xF4)
+            return 4;
+        return 0;
+    }
+
+    std::vector<CodePointRange> NormalizeRanges(std::vector<CodePointRange> ranges, char32_t max_symbol) {
+        std::sort(ranges.begin(), ranges.end());
+        std::vector<CodePointRange> result;
+        for (auto [from, to] : ranges) {
+            from = std::max<char32_t>(from, 1);
+            to = std::min(to, max_symbol);
+            if (from > to)
+                continue;
+            if (!result.empty() && from <= result.back().second + 1)
+                result.back().second = std::max(result.back().second, to);
+            else
+                result.emplace_back(from, to);
+        }
+        if (max_symbol != kMaxCodePoint)
+            return result;
+
+        std::vector<CodePointRange> valid;
+        for (const auto &[from, to] : result) {
+            if (to < kSurrogateBegin || from > kSurrogateEnd) {
+                valid.emplace_back(from, to);
+                continue;
+            }
+            if (from < kSurrogateBegin)
+                valid.emplace_back(from, kSurrogateBegin - 1);
+            if (to > kSurrogateEnd)
+                valid.emplace_back(kSurrogateEnd + 1, to);
+        }
+        return valid;
+    }
+
+    std::vector<CodePointRange> ComplementRanges(const std::vector<CodePointRange> &ranges, char32_t max_symbol) {
+        std::vector<CodePointRange> complement;
+        char32_t next = 1;
+        for (const auto &[from, to] : NormalizeRanges(ranges, max_symbol)) {
+            if (from > next)
+                complement.emplace_back(next, from - 1);
+            next = to + 1;
+        }
+        if (next <= max_symbol)
+            complement.emplace_back(next, max_symbol);
+        return NormalizeRanges(complement, max_symbol);
+    }
+
+    RegexNodePtr CreateByteClass(const std::vector<CodePointRange> &ranges) {
+        std::set<char> bytes;
+        for (const auto &[from, to] : NormalizeRanges(ranges, kMaxByte)) {
+            for (char32_t c = from; c <= to; ++c)
+                bytes.insert((char) c);
+        }
+        return RegexNode::Class(bytes);
+    }
+
+    RegexNodePtr CreateUtf8Class(const std::vector<CodePointRange> &ranges) {
+        std::vector<ByteSequence> sequences;
+        for (const auto &[from, to] : NormalizeRanges(ranges, kMaxCodePoint))
+            SplitRange(from, to, sequences);
+
+        // Single bytes share one class, longer sequences become a concatenation of byte classes each.
+        std::vector<CodePointRange> single_bytes;
+        std::vector<RegexNodePtr> alternatives = {nullptr};
+        for (const auto &sequence : sequences) {
+            if (sequence.size() == 1) {
+                single_bytes.emplace_back(sequence[0].first, sequence[0].second);
+                continue;
+            }
+            std::vector<RegexNodePtr> factors;
+            for (const auto &[from, to] : sequence)
+                factors.push_back(CreateByteRange(from, to));
+            alternatives.push_back(RegexNode::Concat(factors));
+        }
+        alternatives[0] = CreateByteClass(single_bytes);
+        if (single_bytes.empty() && alternatives.size() > 1)
+            alternatives.erase(alternatives.begin());
+        return alternatives.size() == 1 ? alternatives[0] : RegexNode::Union(alternatives);
+    }
+} //namespace compiler::regex